@@ -0,0 +1,54 @@
+#pragma once
+
+#include <stdio.h>
+#include <time.h>
+
+#include "nclib/streams/stream_endian.h"
+#include "nclib/typedefs.h"
+
+#define BENCH_RUNS 7
+#define BENCH_BUFFER_SIZE (1024 * 1024)
+
+/* Benchmarked function returns something computed from data, so compiler
+ * can't throw work away. */
+typedef u64 (*BenchFn)(void* ctx);
+
+static volatile u64 bench_sink;
+
+[[maybe_unused]] static f64 bench_now(void)
+{
+    struct timespec ts;
+
+#ifdef TIME_MONOTONIC
+    timespec_get(&ts, TIME_MONOTONIC);
+#else
+    timespec_get(&ts, TIME_UTC);
+#endif
+
+    return (f64)ts.tv_sec + (f64)ts.tv_nsec * 1e-9;
+}
+
+/* Run `fn` BENCH_RUNS times and print best run as one JSON line. */
+[[maybe_unused]] static void bench_run(char const* name, StreamEndian endian,
+                                       u64 ops, u64 bytes, BenchFn fn,
+                                       void* ctx)
+{
+    f64 best = 0.0;
+
+    for (u64 run = 0; run < BENCH_RUNS; ++run) {
+        f64 start = bench_now();
+        bench_sink = bench_sink + fn(ctx);
+        f64 elapsed = bench_now() - start;
+
+        if (run == 0 or elapsed < best) {
+            best = elapsed;
+        }
+    }
+
+    printf("{\"name\": \"%s\", \"endian\": \"%s\", \"swapped\": %s, "
+           "\"ops\": %lu, \"bytes\": %lu, \"seconds\": %.9f, "
+           "\"ns_per_op\": %.3f, \"gb_per_s\": %.3f}\n",
+           name, endian == STREAM_BIG_ENDIAN ? "be" : "le",
+           endian == MACHINE_ENDIAN ? "false" : "true", ops, bytes, best,
+           best * 1e9 / (f64)ops, (f64)bytes / best * 1e-9);
+}
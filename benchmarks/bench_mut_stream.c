@@ -0,0 +1,108 @@
+#include <stdlib.h>
+
+#include "bench.h"
+#include "nclib/streams/mut_stream.h"
+
+/********************************************
+ *              DEFINES START.              *
+ ********************************************/
+
+#define GEN_WRITE_BENCH_FOR(_type_)                                           \
+    static u64 bench_write_##_type_(void* ctx)                                \
+    {                                                                         \
+        MutStream* stream = ctx;                                              \
+        u64 count = mut_stream_size(stream) / sizeof(_type_);                 \
+                                                                              \
+        mut_stream_seek(stream, 0, STREAM_START);                             \
+        for (u64 i = 0; i < count; ++i) {                                     \
+            mut_stream_write_##_type_(stream, (_type_)i);                     \
+        }                                                                     \
+        return mut_stream_raw(stream)[count / 2];                             \
+    }
+
+#define RUN_WRITE_BENCH_FOR(_type_, _stream_)                                 \
+    bench_run("mut_stream_write_" #_type_, (_stream_)->_endian,               \
+              mut_stream_size(_stream_) / sizeof(_type_),                     \
+              mut_stream_size(_stream_) / sizeof(_type_) * sizeof(_type_),    \
+              bench_write_##_type_, _stream_)
+
+#define WRITE_BYTES_SIZES_COUNT 5
+
+/********************************************
+ *              DEFINES END.                *
+ ********************************************/
+
+typedef struct {
+    MutStream* stream;
+    u8 const* src;
+    u64 size;
+} WriteBytesCtx;
+
+GEN_WRITE_BENCH_FOR(u8)
+GEN_WRITE_BENCH_FOR(i8)
+GEN_WRITE_BENCH_FOR(u16)
+GEN_WRITE_BENCH_FOR(i16)
+GEN_WRITE_BENCH_FOR(u32)
+GEN_WRITE_BENCH_FOR(i32)
+GEN_WRITE_BENCH_FOR(u64)
+GEN_WRITE_BENCH_FOR(i64)
+GEN_WRITE_BENCH_FOR(f32)
+GEN_WRITE_BENCH_FOR(f64)
+GEN_WRITE_BENCH_FOR(bool)
+
+static u64 bench_write_bytes(void* ctx)
+{
+    WriteBytesCtx* bytes_ctx = ctx;
+    MutStream* stream = bytes_ctx->stream;
+    u64 count = mut_stream_size(stream) / bytes_ctx->size;
+
+    mut_stream_seek(stream, 0, STREAM_START);
+    for (u64 i = 0; i < count; ++i) {
+        mut_stream_write_bytes(stream, bytes_ctx->src, bytes_ctx->size);
+    }
+    return mut_stream_tell(stream);
+}
+
+static void bench_mut_stream(u8* buf, StreamEndian endian)
+{
+    MutStream stream = mut_stream_new(buf, BENCH_BUFFER_SIZE, endian);
+
+    RUN_WRITE_BENCH_FOR(u8, &stream);
+    RUN_WRITE_BENCH_FOR(i8, &stream);
+    RUN_WRITE_BENCH_FOR(u16, &stream);
+    RUN_WRITE_BENCH_FOR(i16, &stream);
+    RUN_WRITE_BENCH_FOR(u32, &stream);
+    RUN_WRITE_BENCH_FOR(i32, &stream);
+    RUN_WRITE_BENCH_FOR(u64, &stream);
+    RUN_WRITE_BENCH_FOR(i64, &stream);
+    RUN_WRITE_BENCH_FOR(f32, &stream);
+    RUN_WRITE_BENCH_FOR(f64, &stream);
+    RUN_WRITE_BENCH_FOR(bool, &stream);
+
+    u64 sizes[WRITE_BYTES_SIZES_COUNT] = { 1, 16, 256, 4096, 65536 };
+    u8* src = calloc(sizes[WRITE_BYTES_SIZES_COUNT - 1], 1);
+    char name[64];
+
+    for (u64 i = 0; i < WRITE_BYTES_SIZES_COUNT; ++i) {
+        WriteBytesCtx ctx = { .stream = &stream, .src = src, .size = sizes[i] };
+        snprintf(name, sizeof name, "mut_stream_write_bytes_%lu", sizes[i]);
+        bench_run(name, endian, BENCH_BUFFER_SIZE / sizes[i],
+                  BENCH_BUFFER_SIZE / sizes[i] * sizes[i], bench_write_bytes,
+                  &ctx);
+    }
+    free(src);
+}
+
+int main(void)
+{
+    u8* buf = malloc(BENCH_BUFFER_SIZE);
+    if (buf == NULL) {
+        return EXIT_FAILURE;
+    }
+
+    bench_mut_stream(buf, STREAM_LITTLE_ENDIAN);
+    bench_mut_stream(buf, STREAM_BIG_ENDIAN);
+
+    free(buf);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,356 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+#include "nclib/streams/stream.h"
+#include "nclib/streams/stream_columns.h"
+#include "nclib/streams/stream_lz4.h"
+#include "nclib/streams/stream_record.h"
+
+/********************************************
+ *              DEFINES START.              *
+ ********************************************/
+
+#define GEN_READ_BENCH_FOR(_type_)                                            \
+    static u64 bench_read_##_type_(void* ctx)                                 \
+    {                                                                         \
+        Stream* stream = ctx;                                                 \
+        u64 count = stream_size(stream) / sizeof(_type_);                     \
+        u64 sum = 0;                                                          \
+                                                                              \
+        /* Sum raw bits, random bytes can be NaN as float. */                 \
+        stream_seek(stream, 0, STREAM_START);                                 \
+        for (u64 i = 0; i < count; ++i) {                                     \
+            _type_ value = stream_read_##_type_(stream);                      \
+            u64 bits = 0;                                                     \
+            memcpy(&bits, &value, sizeof value);                              \
+            sum += bits;                                                      \
+        }                                                                     \
+        return sum;                                                           \
+    }
+
+#define RUN_READ_BENCH_FOR(_type_, _stream_)                                  \
+    bench_run("stream_read_" #_type_, (_stream_)->_endian,                    \
+              stream_size(_stream_) / sizeof(_type_),                         \
+              stream_size(_stream_) / sizeof(_type_) * sizeof(_type_),        \
+              bench_read_##_type_, _stream_)
+
+#define READ_BYTES_SIZES_COUNT 5
+#define SEEKS_COUNT (1024 * 1024)
+#define HEADER_SIZE 64
+
+#define BENCH_HEADER_FIELDS(X)                                                \
+    X(u32, magic)                                                             \
+    X(u16, version)                                                           \
+    X(u16, flags)                                                             \
+    X(u64, field0)                                                            \
+    X(u64, field1)                                                            \
+    X(u64, field2)                                                            \
+    X(u64, field3)                                                            \
+    X(u64, field4)                                                            \
+    X(u64, field5)                                                            \
+    X(u64, field6)
+
+#define BENCH_ADDR_FIELDS(X)                                                  \
+    X(i32, page_id)                                                           \
+    X(i16, offset)
+
+#define BENCH_ADDR_SIZE 6
+
+// Text of random words, compresses about 2.5 times.
+#define BENCH_LZ4_WORDS_COUNT 8
+
+/********************************************
+ *              DEFINES END.                *
+ ********************************************/
+
+STREAM_RECORD_DEFINE(BenchHeader, bench_header, BENCH_HEADER_FIELDS)
+
+typedef struct {
+    Stream* stream;
+    u8* dst;
+    u64 size;
+} ReadBytesCtx;
+
+typedef struct {
+    Stream* stream;
+    i32* page_ids;
+    i16* offsets;
+} ReadAddrsCtx;
+
+GEN_READ_BENCH_FOR(u8)
+GEN_READ_BENCH_FOR(i8)
+GEN_READ_BENCH_FOR(u16)
+GEN_READ_BENCH_FOR(i16)
+GEN_READ_BENCH_FOR(u32)
+GEN_READ_BENCH_FOR(i32)
+GEN_READ_BENCH_FOR(u64)
+GEN_READ_BENCH_FOR(i64)
+GEN_READ_BENCH_FOR(f32)
+GEN_READ_BENCH_FOR(f64)
+GEN_READ_BENCH_FOR(bool)
+
+static u64 bench_read_bytes(void* ctx)
+{
+    ReadBytesCtx* bytes_ctx = ctx;
+    Stream* stream = bytes_ctx->stream;
+    u64 count = stream_size(stream) / bytes_ctx->size;
+    u64 sum = 0;
+
+    stream_seek(stream, 0, STREAM_START);
+    for (u64 i = 0; i < count; ++i) {
+        stream_read_bytes(stream, bytes_ctx->dst, bytes_ctx->size);
+        sum += bytes_ctx->dst[0];
+    }
+    return sum;
+}
+
+static u64 bench_seek(void* ctx)
+{
+    Stream* stream = ctx;
+    u64 size = stream_size(stream);
+    u64 sum = 0;
+
+    // Jump over buffer in pseudo random order.
+    for (u64 i = 0; i < SEEKS_COUNT; ++i) {
+        sum += stream_seek(stream, (i64)(i * 7919 % size), STREAM_START);
+        sum += stream_seek(stream, -3, STREAM_CURR);
+    }
+    return sum;
+}
+
+// Header: u32 magic, u16 version, u16 flags and 7 u64 fields.
+static u64 bench_read_header(void* ctx)
+{
+    Stream* stream = ctx;
+    u64 count = stream_size(stream) / HEADER_SIZE;
+    u64 sum = 0;
+
+    stream_seek(stream, 0, STREAM_START);
+    for (u64 i = 0; i < count; ++i) {
+        sum += stream_read_u32(stream);
+        sum += stream_read_u16(stream);
+        sum += stream_read_u16(stream);
+        for (u64 j = 0; j < 7; ++j) {
+            sum += stream_read_u64(stream);
+        }
+    }
+    return sum;
+}
+
+static u64 bench_read_header_unchecked(void* ctx)
+{
+    Stream* stream = ctx;
+    u64 count = stream_size(stream) / HEADER_SIZE;
+    u64 sum = 0;
+
+    stream_seek(stream, 0, STREAM_START);
+    for (u64 i = 0; i < count; ++i) {
+        if (not stream_ensure(stream, HEADER_SIZE)) {
+            break;
+        }
+        sum += stream_read_u32_unchecked(stream);
+        sum += stream_read_u16_unchecked(stream);
+        sum += stream_read_u16_unchecked(stream);
+        for (u64 j = 0; j < 7; ++j) {
+            sum += stream_read_u64_unchecked(stream);
+        }
+    }
+    return sum;
+}
+
+static u64 bench_read_header_record(void* ctx)
+{
+    Stream* stream = ctx;
+    u64 count = stream_size(stream) / HEADER_SIZE;
+    u64 sum = 0;
+
+    stream_seek(stream, 0, STREAM_START);
+    for (u64 i = 0; i < count; ++i) {
+        BenchHeader header = stream_read_bench_header(stream);
+        sum += header.magic + header.version + header.flags + header.field0
+            + header.field1 + header.field2 + header.field3 + header.field4
+            + header.field5 + header.field6;
+    }
+    return sum;
+}
+
+static u64 bench_read_addrs(void* ctx)
+{
+    ReadAddrsCtx* addrs_ctx = ctx;
+    Stream* stream = addrs_ctx->stream;
+    u64 count = stream_size(stream) / BENCH_ADDR_SIZE;
+
+    stream_seek(stream, 0, STREAM_START);
+    for (u64 i = 0; i < count; ++i) {
+        addrs_ctx->page_ids[i] = stream_read_i32(stream);
+        addrs_ctx->offsets[i] = stream_read_i16(stream);
+    }
+    return (u64)addrs_ctx->page_ids[count - 1];
+}
+
+static u64 bench_read_addrs_columns(void* ctx)
+{
+    ReadAddrsCtx* addrs_ctx = ctx;
+    Stream* stream = addrs_ctx->stream;
+    u64 count = stream_size(stream) / BENCH_ADDR_SIZE;
+
+    stream_seek(stream, 0, STREAM_START);
+    stream_read_columns(stream, STREAM_COLUMNS_LAYOUT(BENCH_ADDR_FIELDS),
+                        (void*[]) { addrs_ctx->page_ids, addrs_ctx->offsets },
+                        count);
+    return (u64)addrs_ctx->page_ids[count - 1];
+}
+
+typedef struct {
+    u8* text;
+    MutStream* compressed;
+    MutStream* out;
+    u32 acceleration;
+} Lz4Ctx;
+
+static u64 bench_write_lz4_block(void* ctx)
+{
+    Lz4Ctx* lz4_ctx = ctx;
+
+    mut_stream_seek(lz4_ctx->compressed, 0, STREAM_START);
+    return mut_stream_write_lz4_block(lz4_ctx->compressed, lz4_ctx->text,
+                                      BENCH_BUFFER_SIZE,
+                                      lz4_ctx->acceleration);
+}
+
+static u64 bench_read_lz4_block(void* ctx)
+{
+    Lz4Ctx* lz4_ctx = ctx;
+    u64 size = mut_stream_tell(lz4_ctx->compressed);
+    Stream stream = stream_new_le(mut_stream_raw(lz4_ctx->compressed), size);
+
+    mut_stream_seek(lz4_ctx->out, 0, STREAM_START);
+    return stream_read_lz4_block(&stream, size, lz4_ctx->out,
+                                 BENCH_BUFFER_SIZE);
+}
+
+static void bench_lz4(StreamEndian endian)
+{
+    char const* words[BENCH_LZ4_WORDS_COUNT] = {
+        "stream ", "read ", "write ", "block ",
+        "frame ",  "bytes ", "u32 ",  "offset ",
+    };
+    u8* text = malloc(BENCH_BUFFER_SIZE);
+    u64 seed = 1;
+
+    for (u64 i = 0; i < BENCH_BUFFER_SIZE;) {
+        seed = seed * 6364136223846793005u + 1442695040888963407u;
+        char const* word = words[(seed >> 33) % BENCH_LZ4_WORDS_COUNT];
+        for (u64 j = 0; word[j] != '\0' and i < BENCH_BUFFER_SIZE; ++j) {
+            text[i++] = (u8)word[j];
+        }
+    }
+
+    MutStream compressed = mut_stream_new_growable_le(
+        stream_lz4_compress_bound(BENCH_BUFFER_SIZE));
+    MutStream out = mut_stream_new_growable_le(BENCH_BUFFER_SIZE);
+    Lz4Ctx ctx = {
+        .text = text,
+        .compressed = &compressed,
+        .out = &out,
+        .acceleration = STREAM_LZ4_ACCELERATION_FAST,
+    };
+
+    bench_run("mut_stream_write_lz4_block_fast", endian, 1,
+              BENCH_BUFFER_SIZE, bench_write_lz4_block, &ctx);
+    ctx.acceleration = STREAM_LZ4_ACCELERATION_DEFAULT;
+    bench_run("mut_stream_write_lz4_block", endian, 1, BENCH_BUFFER_SIZE,
+              bench_write_lz4_block, &ctx);
+    bench_run("stream_read_lz4_block", endian, 1, BENCH_BUFFER_SIZE,
+              bench_read_lz4_block, &ctx);
+
+    mut_stream_free(&out);
+    mut_stream_free(&compressed);
+    free(text);
+}
+
+static void bench_stream(u8 const* buf, u8 const* bools, StreamEndian endian)
+{
+    Stream stream = stream_new(buf, BENCH_BUFFER_SIZE, endian);
+    Stream bool_stream = stream_new(bools, BENCH_BUFFER_SIZE, endian);
+
+    RUN_READ_BENCH_FOR(u8, &stream);
+    RUN_READ_BENCH_FOR(i8, &stream);
+    RUN_READ_BENCH_FOR(u16, &stream);
+    RUN_READ_BENCH_FOR(i16, &stream);
+    RUN_READ_BENCH_FOR(u32, &stream);
+    RUN_READ_BENCH_FOR(i32, &stream);
+    RUN_READ_BENCH_FOR(u64, &stream);
+    RUN_READ_BENCH_FOR(i64, &stream);
+    RUN_READ_BENCH_FOR(f32, &stream);
+    RUN_READ_BENCH_FOR(f64, &stream);
+    RUN_READ_BENCH_FOR(bool, &bool_stream);
+
+    u64 sizes[READ_BYTES_SIZES_COUNT] = { 1, 16, 256, 4096, 65536 };
+    u8* dst = malloc(sizes[READ_BYTES_SIZES_COUNT - 1]);
+    char name[64];
+
+    for (u64 i = 0; i < READ_BYTES_SIZES_COUNT; ++i) {
+        ReadBytesCtx ctx = { .stream = &stream, .dst = dst, .size = sizes[i] };
+        snprintf(name, sizeof name, "stream_read_bytes_%lu", sizes[i]);
+        bench_run(name, endian, BENCH_BUFFER_SIZE / sizes[i],
+                  BENCH_BUFFER_SIZE / sizes[i] * sizes[i], bench_read_bytes,
+                  &ctx);
+    }
+    free(dst);
+
+    bench_run("stream_read_header", endian, BENCH_BUFFER_SIZE / HEADER_SIZE,
+              BENCH_BUFFER_SIZE, bench_read_header, &stream);
+    bench_run("stream_read_header_unchecked", endian,
+              BENCH_BUFFER_SIZE / HEADER_SIZE, BENCH_BUFFER_SIZE,
+              bench_read_header_unchecked, &stream);
+    bench_run("stream_read_header_record", endian,
+              BENCH_BUFFER_SIZE / HEADER_SIZE, BENCH_BUFFER_SIZE,
+              bench_read_header_record, &stream);
+
+    Stream fallible = stream_new_fallible(buf, BENCH_BUFFER_SIZE, endian);
+    bench_run("stream_read_header_fallible", endian,
+              BENCH_BUFFER_SIZE / HEADER_SIZE, BENCH_BUFFER_SIZE,
+              bench_read_header, &fallible);
+
+    u64 addrs_count = BENCH_BUFFER_SIZE / BENCH_ADDR_SIZE;
+    ReadAddrsCtx addrs_ctx = {
+        .stream = &stream,
+        .page_ids = malloc(addrs_count * sizeof(i32)),
+        .offsets = malloc(addrs_count * sizeof(i16)),
+    };
+    bench_run("stream_read_addrs", endian, addrs_count,
+              addrs_count * BENCH_ADDR_SIZE, bench_read_addrs, &addrs_ctx);
+    bench_run("stream_read_addrs_columns", endian, addrs_count,
+              addrs_count * BENCH_ADDR_SIZE, bench_read_addrs_columns,
+              &addrs_ctx);
+    free(addrs_ctx.page_ids);
+    free(addrs_ctx.offsets);
+
+    bench_run("stream_seek", endian, SEEKS_COUNT * 2, 0, bench_seek, &stream);
+
+    bench_lz4(endian);
+}
+
+int main(void)
+{
+    u8* buf = malloc(BENCH_BUFFER_SIZE);
+    u8* bools = malloc(BENCH_BUFFER_SIZE);
+    if (buf == NULL or bools == NULL) {
+        return EXIT_FAILURE;
+    }
+
+    // Any byte other than 0 and 1 isn't valid bool.
+    for (u64 i = 0; i < BENCH_BUFFER_SIZE; ++i) {
+        buf[i] = (u8)(i * 31 + 7);
+        bools[i] = (u8)((i * 31 + 7) >> 4 & 1);
+    }
+
+    bench_stream(buf, bools, STREAM_LITTLE_ENDIAN);
+    bench_stream(buf, bools, STREAM_BIG_ENDIAN);
+
+    free(bools);
+    free(buf);
+    return EXIT_SUCCESS;
+}
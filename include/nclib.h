@@ -5,6 +5,12 @@
     "little endian"
 #endif // !MACHINE_ENDIAN
 
+#include "nclib/alloc/alloc.h"
+#include "nclib/checksum/checksum.h"
+#include "nclib/darray/darray.h"
+#include "nclib/hash_table/hash_table.h"
 #include "nclib/panic.h"
+#include "nclib/queue/queue.h"
+#include "nclib/str/strs.h"
 #include "nclib/streams/streams.h"
 #include "nclib/typedefs.h"
@@ -0,0 +1,4 @@
+#pragma once
+
+#include "arena.h"
+#include "pool.h"
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "nclib/typedefs.h"
+
+#define ARENA_DEFAULT_BLOCK_SIZE (64 * 1024)
+#define ARENA_DEFAULT_ALIGN (_Alignof(max_align_t))
+#define ARENA_SCRATCH_COUNT 2
+
+typedef struct ArenaBlock ArenaBlock;
+
+/* Bump pointer allocator. Memory is taken from chain of blocks and is freed
+ * all together by arena_free. Reset and restore keep blocks for reuse. */
+typedef struct {
+    ArenaBlock* _first;
+    ArenaBlock* _block;
+    u8* _ptr;
+    u8* _end;
+    u64 _block_size;
+} Arena;
+
+/* Position inside arena, restoring it frees everything allocated after. */
+typedef struct {
+    ArenaBlock* _block;
+    u8* _ptr;
+} ArenaCheckpoint;
+
+/* Thread local arena borrowed by arena_scratch_begin. */
+typedef struct {
+    Arena* arena;
+    ArenaCheckpoint checkpoint;
+} ArenaScratch;
+
+Arena arena_new(u64 block_size);
+void arena_free(Arena* arena);
+
+void* arena_alloc_zeroed(Arena* arena, u64 size);
+
+ArenaCheckpoint arena_save(Arena const* arena);
+void arena_restore(Arena* arena, ArenaCheckpoint checkpoint);
+void arena_reset(Arena* arena);
+
+ArenaScratch arena_scratch_begin(Arena* const* conflicts, u64 conflicts_count);
+void arena_scratch_end(ArenaScratch scratch);
+void arena_scratch_free(void);
+
+void* _arena_alloc_slow(Arena* arena, u64 size, u64 align);
+
+/* Allocate `size` bytes aligned by `align` (power of two). */
+[[maybe_unused]] static inline void* arena_alloc_aligned(Arena* arena,
+                                                         u64 size, u64 align)
+{
+    uintptr_t ptr = ((uintptr_t)arena->_ptr + (align - 1)) & ~(align - 1);
+    uintptr_t end = (uintptr_t)arena->_end;
+
+    if (ptr > end or size > end - ptr) {
+        return _arena_alloc_slow(arena, size, align);
+    }
+
+    arena->_ptr = (u8*)(ptr + size);
+    return (void*)ptr;
+}
+
+[[maybe_unused]] static inline void* arena_alloc(Arena* arena, u64 size)
+{
+    return arena_alloc_aligned(arena, size, ARENA_DEFAULT_ALIGN);
+}
+
+#define arena_new_array(_arena_, _type_, _count_)                             \
+    ((_type_*)arena_alloc_aligned(_arena_, sizeof(_type_) * (_count_),        \
+                                  _Alignof(_type_)))
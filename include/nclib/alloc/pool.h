@@ -0,0 +1,96 @@
+#pragma once
+
+#include <stdatomic.h>
+#include <stddef.h>
+
+#include "nclib/typedefs.h"
+
+#define POOL_DEFAULT_SLAB_SLOTS 1024
+// Cache keeps up to POOL_CACHE_SIZE free slots and moves them to and from
+// pool by POOL_CACHE_BATCH, so pool lock is taken once per batch.
+#define POOL_CACHE_SIZE 64
+#define POOL_CACHE_BATCH 32
+
+typedef struct PoolSlot PoolSlot;
+typedef struct PoolSlab PoolSlab;
+
+/* Allocator of fixed size slots. Free slots are chained into free list, new
+ * slots are cut from slabs of `_slab_slots` slots. Slabs are freed all
+ * together by pool_free. Pool is shared between threads, every thread
+ * allocates through own PoolCache. */
+typedef struct {
+    PoolSlot* _free;
+    PoolSlab* _slabs;
+    u8* _ptr;
+    u8* _end;
+    u64 _slot_size;
+    u64 _slot_align;
+    u64 _slab_slots;
+    i64 _in_use;
+    i64 _high_water;
+    atomic_flag _lock;
+} Pool;
+
+/* Per thread free list of pool. Allocations are counted locally (with
+ * their peak) and are added to pool stats when cache exchanges batch with
+ * pool. */
+typedef struct {
+    Pool* _pool;
+    PoolSlot* _free;
+    u64 _count;
+    i64 _in_use;
+    i64 _peak;
+} PoolCache;
+
+struct PoolSlot {
+    PoolSlot* _next;
+};
+
+Pool pool_new(u64 slot_size, u64 slot_align, u64 slab_slots);
+void pool_free(Pool* pool);
+
+void* pool_alloc(Pool* pool);
+void pool_release(Pool* pool, void* ptr);
+
+u64 pool_in_use(Pool* pool);
+u64 pool_high_water(Pool* pool);
+
+PoolCache pool_cache_new(Pool* pool);
+void pool_cache_flush(PoolCache* cache);
+
+void _pool_cache_refill(PoolCache* cache);
+void _pool_cache_drain(PoolCache* cache);
+
+[[maybe_unused]] static inline void* pool_cache_alloc(PoolCache* cache)
+{
+    if (cache->_free == NULL) {
+        _pool_cache_refill(cache);
+    }
+
+    PoolSlot* slot = cache->_free;
+    cache->_free = slot->_next;
+    --cache->_count;
+    if (++cache->_in_use > cache->_peak) {
+        cache->_peak = cache->_in_use;
+    }
+    return slot;
+}
+
+[[maybe_unused]] static inline void pool_cache_release(PoolCache* cache,
+                                                       void* ptr)
+{
+    PoolSlot* slot = ptr;
+    slot->_next = cache->_free;
+    cache->_free = slot;
+    --cache->_in_use;
+
+    if (++cache->_count >= POOL_CACHE_SIZE) {
+        _pool_cache_drain(cache);
+    }
+}
+
+#define pool_new_for(_type_, _slab_slots_)                                    \
+    pool_new(sizeof(_type_), _Alignof(_type_), _slab_slots_)
+
+#define pool_cache_new_item(_cache_, _type_)                                  \
+    ((_type_*)pool_cache_alloc(_cache_))
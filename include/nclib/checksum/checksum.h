@@ -0,0 +1,4 @@
+#pragma once
+
+#include "crc32c.h"
+#include "xxh32.h"
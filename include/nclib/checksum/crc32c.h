@@ -0,0 +1,9 @@
+#pragma once
+
+#include "nclib/typedefs.h"
+
+/* CRC32C (Castagnoli) of `size` bytes. Pass 0 as `crc` for new checksum or
+ * previous result to continue it, so crc32c(crc32c(0, a), b) is checksum of
+ * a followed by b. Uses SSE4.2 crc32 instruction when cpu supports it and
+ * slice-by-8 tables otherwise. */
+u32 crc32c(u32 crc, void const* data, u64 size);
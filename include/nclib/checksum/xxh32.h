@@ -0,0 +1,20 @@
+#pragma once
+
+#include "nclib/typedefs.h"
+
+/* Incremental xxHash32 state. Bytes are hashed by 16 byte stripes, tail
+ * which doesn't fill stripe waits in `_buf` for next update. */
+typedef struct {
+    u32 _acc[4];
+    u64 _total;
+    u8 _buf[16];
+    u32 _buf_size;
+    u32 _seed;
+} Xxh32;
+
+/* xxHash32 of `size` bytes (format used by LZ4 frames). */
+u32 xxh32(u32 seed, void const* data, u64 size);
+
+Xxh32 xxh32_begin(u32 seed);
+void xxh32_update(Xxh32* state, void const* data, u64 size);
+u32 xxh32_end(Xxh32 const* state);
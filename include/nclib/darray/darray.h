@@ -0,0 +1,190 @@
+#pragma once
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "nclib/panic.h"
+#include "nclib/typedefs.h"
+
+#define DARRAY_MIN_CAPACITY 8
+
+#ifdef CHECK_BOUND
+
+#define DARRAY_CHECK_BOUND(_array_, _index_)                                  \
+    if (_index_ >= _array_->_len) {                                           \
+        panic("Error: darray access out of bound at %s:%d. Len=%lu, access "  \
+              "by index=%lu.\n",                                              \
+              __FILE__, __LINE__, _array_->_len, _index_);                    \
+    }
+
+#else
+
+#define DARRAY_CHECK_BOUND(_array_, _index_)
+
+#endif // endif !CHECK_BOUND
+
+/* New capacity for `needed` items, capacity grows at least twice, so push
+ * costs amortized O(1) copies. */
+[[maybe_unused]] static inline u64 _darray_grow_capacity(u64 capacity,
+                                                         u64 needed)
+{
+    u64 doubled = capacity * 2;
+
+    if (doubled < DARRAY_MIN_CAPACITY) {
+        doubled = DARRAY_MIN_CAPACITY;
+    }
+    return needed > doubled ? needed : doubled;
+}
+
+[[maybe_unused]] static inline void* _darray_realloc(void* data, u64 capacity,
+                                                     u64 item_size)
+{
+    if (capacity == 0) {
+        free(data);
+        return NULL;
+    }
+
+    void* new_data = realloc(data, capacity * item_size);
+    if (new_data == NULL) {
+        panic("Error: can't allocate %lu bytes for darray.\n",
+              capacity * item_size);
+    }
+    return new_data;
+}
+
+/* Define dynamic array type `_name_` of `_type_` items and its methods with
+ * `_name_` prefix (_name_##_push, _name_##_reserve and so on). */
+#define DARRAY_DEFINE(_name_, _type_)                                         \
+    typedef struct {                                                          \
+        _type_* _data;                                                        \
+        u64 _len;                                                             \
+        u64 _capacity;                                                        \
+    } _name_;                                                                 \
+                                                                              \
+    [[maybe_unused]] static inline _name_ _name_##_new(void)                  \
+    {                                                                         \
+        return (_name_) { ._data = NULL, ._len = 0, ._capacity = 0 };         \
+    }                                                                         \
+                                                                              \
+    [[maybe_unused]] static inline void _name_##_free(_name_* array)          \
+    {                                                                         \
+        free(array->_data);                                                   \
+        *array = _name_##_new();                                              \
+    }                                                                         \
+                                                                              \
+    [[maybe_unused]] static inline void _name_##_reserve(_name_* array,       \
+                                                         u64 capacity)        \
+    {                                                                         \
+        if (capacity <= array->_capacity) {                                   \
+            return;                                                           \
+        }                                                                     \
+        array->_capacity = _darray_grow_capacity(array->_capacity, capacity); \
+        array->_data = _darray_realloc(array->_data, array->_capacity,        \
+                                       sizeof(_type_));                       \
+    }                                                                         \
+                                                                              \
+    [[maybe_unused]] static inline _name_ _name_##_with_capacity(             \
+        u64 capacity)                                                         \
+    {                                                                         \
+        _name_ array = _name_##_new();                                        \
+        _name_##_reserve(&array, capacity);                                   \
+        return array;                                                         \
+    }                                                                         \
+                                                                              \
+    [[maybe_unused]] static inline void _name_##_shrink_to_fit(               \
+        _name_* array)                                                        \
+    {                                                                         \
+        if (array->_len == array->_capacity) {                                \
+            return;                                                           \
+        }                                                                     \
+        array->_data                                                          \
+            = _darray_realloc(array->_data, array->_len, sizeof(_type_));     \
+        array->_capacity = array->_len;                                       \
+    }                                                                         \
+                                                                              \
+    /* Grow len by `count` and return pointer to new uninitialized items, */ \
+    /* bulk decoders can write straight into it. */                          \
+    [[maybe_unused]] static inline _type_* _name_##_extend(_name_* array,     \
+                                                           u64 count)         \
+    {                                                                         \
+        _name_##_reserve(array, array->_len + count);                         \
+        _type_* items = array->_data + array->_len;                           \
+        array->_len += count;                                                 \
+        return items;                                                         \
+    }                                                                         \
+                                                                              \
+    [[maybe_unused]] static inline void _name_##_push(_name_* array,          \
+                                                      _type_ item)            \
+    {                                                                         \
+        if (array->_len == array->_capacity) {                                \
+            _name_##_reserve(array, array->_len + 1);                         \
+        }                                                                     \
+        array->_data[array->_len++] = item;                                   \
+    }                                                                         \
+                                                                              \
+    [[maybe_unused]] static inline void _name_##_append_n(                    \
+        _name_* array, _type_ const* items, u64 count)                        \
+    {                                                                         \
+        if (count == 0) {                                                     \
+            return;                                                           \
+        }                                                                     \
+        memcpy(_name_##_extend(array, count), items, count * sizeof(_type_)); \
+    }                                                                         \
+                                                                              \
+    [[maybe_unused]] static inline _type_ _name_##_pop(_name_* array)         \
+    {                                                                         \
+        DARRAY_CHECK_BOUND(array, (u64)0);                                    \
+        return array->_data[--array->_len];                                   \
+    }                                                                         \
+                                                                              \
+    [[maybe_unused]] static inline _type_* _name_##_at(_name_* array,         \
+                                                       u64 index)             \
+    {                                                                         \
+        DARRAY_CHECK_BOUND(array, index);                                     \
+        return array->_data + index;                                          \
+    }                                                                         \
+                                                                              \
+    [[maybe_unused]] static inline _type_ _name_##_get(_name_ const* array,   \
+                                                       u64 index)             \
+    {                                                                         \
+        DARRAY_CHECK_BOUND(array, index);                                     \
+        return array->_data[index];                                           \
+    }                                                                         \
+                                                                              \
+    [[maybe_unused]] static inline void _name_##_set(_name_* array,           \
+                                                     u64 index, _type_ item)  \
+    {                                                                         \
+        DARRAY_CHECK_BOUND(array, index);                                     \
+        array->_data[index] = item;                                           \
+    }                                                                         \
+                                                                              \
+    /* Remove item in O(1) by moving last item to its place. */              \
+    [[maybe_unused]] static inline _type_ _name_##_swap_remove(               \
+        _name_* array, u64 index)                                             \
+    {                                                                         \
+        DARRAY_CHECK_BOUND(array, index);                                     \
+        _type_ item = array->_data[index];                                    \
+        array->_data[index] = array->_data[--array->_len];                    \
+        return item;                                                          \
+    }                                                                         \
+                                                                              \
+    [[maybe_unused]] static inline void _name_##_clear(_name_* array)         \
+    {                                                                         \
+        array->_len = 0;                                                      \
+    }                                                                         \
+                                                                              \
+    [[maybe_unused]] static inline _type_* _name_##_data(_name_* array)       \
+    {                                                                         \
+        return array->_data;                                                  \
+    }                                                                         \
+                                                                              \
+    [[maybe_unused]] static inline u64 _name_##_len(_name_ const* array)      \
+    {                                                                         \
+        return array->_len;                                                   \
+    }                                                                         \
+                                                                              \
+    [[maybe_unused]] static inline u64 _name_##_capacity(                     \
+        _name_ const* array)                                                  \
+    {                                                                         \
+        return array->_capacity;                                              \
+    }
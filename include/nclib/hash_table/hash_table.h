@@ -0,0 +1,69 @@
+#pragma once
+
+#include "nclib/alloc/arena.h"
+#include "nclib/typedefs.h"
+
+#define HASH_TABLE_GROUP_WIDTH 16
+
+typedef u64 (*HashTableHashFn)(void const* key);
+typedef bool (*HashTableEqFn)(void const* left, void const* right);
+
+/* Open addressing hash table (Swiss table). Every slot has control byte with
+ * 7 bits of hash, lookup compares 16 control bytes at once and checks keys
+ * only for matched slots. Keys and values are copied into table, their
+ * alignment must be at most 8. */
+typedef struct {
+    u8* _ctrl;
+    u8* _slots;
+    u64 _capacity;
+    u64 _size;
+    u64 _growth_left;
+    u64 _key_size;
+    u64 _value_size;
+    u64 _value_offset;
+    u64 _slot_size;
+    HashTableHashFn _hash;
+    HashTableEqFn _eq;
+    Arena* _arena;
+} HashTable;
+
+HashTable hash_table_new(u64 key_size, u64 value_size, HashTableHashFn hash,
+                         HashTableEqFn eq);
+HashTable hash_table_new_in_arena(u64 key_size, u64 value_size,
+                                  HashTableHashFn hash, HashTableEqFn eq,
+                                  Arena* arena);
+void hash_table_free(HashTable* table);
+
+void hash_table_reserve(HashTable* table, u64 count);
+void hash_table_clear(HashTable* table);
+
+void* hash_table_get(HashTable const* table, void const* key);
+void* hash_table_insert(HashTable* table, void const* key, void const* value);
+bool hash_table_remove(HashTable* table, void const* key);
+bool hash_table_next(HashTable const* table, u64* index, void** key,
+                     void** value);
+
+u64 hash_table_hash_bytes(void const* data, u64 size);
+u64 hash_table_hash_u32(void const* key);
+u64 hash_table_hash_u64(void const* key);
+u64 hash_table_hash_str_view(void const* key);
+bool hash_table_eq_u32(void const* left, void const* right);
+bool hash_table_eq_u64(void const* left, void const* right);
+bool hash_table_eq_str_view(void const* left, void const* right);
+
+[[maybe_unused]] static inline u64 hash_table_size(HashTable const* table)
+{
+    return table->_size;
+}
+
+[[maybe_unused]] static inline u64
+hash_table_capacity(HashTable const* table)
+{
+    return table->_capacity;
+}
+
+[[maybe_unused]] static inline bool
+hash_table_contains(HashTable const* table, void const* key)
+{
+    return hash_table_get(table, key) != NULL;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <stdatomic.h>
+
+#include "nclib/typedefs.h"
+
+#define MPMC_QUEUE_CACHE_LINE 64
+
+/* Bounded multi producer multi consumer queue (Dmitry Vyukov's design).
+ * Every cell has sequence number which tells whether cell is free for push
+ * or full for pop at given position, so producers and consumers only race
+ * for their own position counter by one CAS. Items are copied into cells,
+ * their alignment must be at most 8.
+ *
+ * Blocking queue additionally wakes sleeping threads after every push and
+ * pop, sleeping uses futex on Linux and spins on other systems. */
+typedef struct {
+    _Alignas(MPMC_QUEUE_CACHE_LINE) _Atomic(u64) _push_pos;
+    _Alignas(MPMC_QUEUE_CACHE_LINE) _Atomic(u64) _pop_pos;
+
+    _Alignas(MPMC_QUEUE_CACHE_LINE) _Atomic(u32) _push_event;
+    _Atomic(u32) _pop_event;
+    _Atomic(u32) _push_waiters;
+    _Atomic(u32) _pop_waiters;
+
+    _Alignas(MPMC_QUEUE_CACHE_LINE) u8* _cells;
+    u64 _mask;
+    u64 _item_size;
+    u64 _cell_size;
+    bool _blocking;
+} MpmcQueue;
+
+/* Capacity must be power of two. */
+MpmcQueue mpmc_queue_new(u64 capacity, u64 item_size);
+MpmcQueue mpmc_queue_new_blocking(u64 capacity, u64 item_size);
+void mpmc_queue_free(MpmcQueue* queue);
+
+/* Return false when queue is full (empty). */
+bool mpmc_queue_try_push(MpmcQueue* queue, void const* item);
+bool mpmc_queue_try_pop(MpmcQueue* queue, void* item);
+
+/* Move up to `count` items by one CAS, return count of moved items. */
+u64 mpmc_queue_try_push_batch(MpmcQueue* queue, void const* items,
+                              u64 count);
+u64 mpmc_queue_try_pop_batch(MpmcQueue* queue, void* items, u64 count);
+
+/* Blocking queue only. Push waits for room, pop waits for item, pop batch
+ * waits for at least one item. */
+void mpmc_queue_push(MpmcQueue* queue, void const* item);
+void mpmc_queue_pop(MpmcQueue* queue, void* item);
+void mpmc_queue_push_batch(MpmcQueue* queue, void const* items, u64 count);
+u64 mpmc_queue_pop_batch(MpmcQueue* queue, void* items, u64 count);
+
+[[maybe_unused]] static inline u64
+mpmc_queue_capacity(MpmcQueue const* queue)
+{
+    return queue->_mask + 1;
+}
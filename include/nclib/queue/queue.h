@@ -0,0 +1,3 @@
+#pragma once
+
+#include "mpmc_queue.h"
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "nclib/typedefs.h"
+#include "str_view.h"
+
+#define STR_INLINE_CAPACITY 15
+
+/* Growable null terminated string. Strings up to STR_INLINE_CAPACITY chars
+ * are stored inside struct without allocation. */
+typedef struct {
+    u64 _len;
+    u64 _capacity;
+    union {
+        char* _heap;
+        char _inline[STR_INLINE_CAPACITY + 1];
+    };
+} Str;
+
+Str str_new(void);
+Str str_with_capacity(u64 capacity);
+Str str_from_cstr(char const* cstr);
+Str str_from_view(StrView view);
+void str_free(Str* str);
+
+void str_reserve(Str* str, u64 capacity);
+void str_append(Str* str, StrView view);
+void str_push(Str* str, char c);
+void str_clear(Str* str);
+
+[[maybe_unused]] static inline bool str_is_inline(Str const* str)
+{
+    return str->_capacity == 0;
+}
+
+[[maybe_unused]] static inline u64 str_len(Str const* str)
+{
+    return str->_len;
+}
+
+[[maybe_unused]] static inline u64 str_capacity(Str const* str)
+{
+    return str_is_inline(str) ? STR_INLINE_CAPACITY : str->_capacity;
+}
+
+[[maybe_unused]] static inline char* str_data(Str* str)
+{
+    return str_is_inline(str) ? str->_inline : str->_heap;
+}
+
+[[maybe_unused]] static inline char const* str_cstr(Str const* str)
+{
+    return str_is_inline(str) ? str->_inline : str->_heap;
+}
+
+[[maybe_unused]] static inline StrView str_view(Str const* str)
+{
+    return (StrView) { .ptr = str_cstr(str), .len = str->_len };
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "nclib/typedefs.h"
+
+#define STR_NOT_FOUND ((u64)-1)
+
+/* Borrowed chars, not null terminated. Valid while owner of chars is alive,
+ * so it can point into Str, string literal or Stream buffer. */
+typedef struct {
+    char const* ptr;
+    u64 len;
+} StrView;
+
+StrView str_view_new(char const* ptr, u64 len);
+StrView str_view_from_cstr(char const* cstr);
+
+bool str_view_eq(StrView left, StrView right);
+bool str_view_starts_with(StrView view, StrView prefix);
+bool str_view_ends_with(StrView view, StrView suffix);
+
+u64 str_view_find_char(StrView view, char c);
+u64 str_view_find(StrView haystack, StrView needle);
+
+StrView str_view_slice(StrView view, u64 start, u64 len);
+bool str_view_split(StrView* rest, char delim, StrView* token);
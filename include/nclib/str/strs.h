@@ -0,0 +1,4 @@
+#pragma once
+
+#include "str.h"
+#include "str_view.h"
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <string.h>
+
+#include "nclib/typedefs.h"
+#include "stream_endian.h"
+
+/* Helpers for loading and storing numbers with selected endian. When endian
+ * is compile time constant compiler turns them into single unaligned load or
+ * store plus bswap instruction. */
+
+[[maybe_unused]] static inline u8 _streams_bswap_u8(u8 num) { return num; }
+
+[[maybe_unused]] static inline u16 _streams_bswap_u16(u16 num)
+{
+#if defined(__GNUC__)
+    return __builtin_bswap16(num);
+#else
+    return (u16)((u16)(num << 8) | (u16)(num >> 8));
+#endif
+}
+
+[[maybe_unused]] static inline u32 _streams_bswap_u32(u32 num)
+{
+#if defined(__GNUC__)
+    return __builtin_bswap32(num);
+#else
+    return ((num & 0x000000ffu) << 24) | ((num & 0x0000ff00u) << 8)
+        | ((num & 0x00ff0000u) >> 8) | ((num & 0xff000000u) >> 24);
+#endif
+}
+
+[[maybe_unused]] static inline u64 _streams_bswap_u64(u64 num)
+{
+#if defined(__GNUC__)
+    return __builtin_bswap64(num);
+#else
+    return ((u64)_streams_bswap_u32((u32)num) << 32)
+        | (u64)_streams_bswap_u32((u32)(num >> 32));
+#endif
+}
+
+#define _STREAMS_GEN_LOAD_STORE_FOR(_type_, _bits_type_)                     \
+    [[maybe_unused]] static inline _type_ _streams_load_##_type_(            \
+        u8 const* src, StreamEndian endian)                                   \
+    {                                                                         \
+        _bits_type_ bits;                                                     \
+        memcpy(&bits, src, sizeof bits);                                      \
+        if (endian != MACHINE_ENDIAN) {                                       \
+            bits = _streams_bswap_##_bits_type_(bits);                        \
+        }                                                                     \
+        _type_ num;                                                           \
+        memcpy(&num, &bits, sizeof num);                                      \
+        return num;                                                           \
+    }                                                                         \
+                                                                              \
+    [[maybe_unused]] static inline void _streams_store_##_type_(             \
+        u8* dst, _type_ num, StreamEndian endian)                             \
+    {                                                                         \
+        _bits_type_ bits;                                                     \
+        memcpy(&bits, &num, sizeof bits);                                     \
+        if (endian != MACHINE_ENDIAN) {                                       \
+            bits = _streams_bswap_##_bits_type_(bits);                        \
+        }                                                                     \
+        memcpy(dst, &bits, sizeof bits);                                      \
+    }
+
+_STREAMS_GEN_LOAD_STORE_FOR(u8, u8)
+_STREAMS_GEN_LOAD_STORE_FOR(i8, u8)
+_STREAMS_GEN_LOAD_STORE_FOR(u16, u16)
+_STREAMS_GEN_LOAD_STORE_FOR(i16, u16)
+_STREAMS_GEN_LOAD_STORE_FOR(u32, u32)
+_STREAMS_GEN_LOAD_STORE_FOR(i32, u32)
+_STREAMS_GEN_LOAD_STORE_FOR(u64, u64)
+_STREAMS_GEN_LOAD_STORE_FOR(i64, u64)
+_STREAMS_GEN_LOAD_STORE_FOR(f32, u32)
+_STREAMS_GEN_LOAD_STORE_FOR(f64, u64)
+_STREAMS_GEN_LOAD_STORE_FOR(bool, u8)
+
+#undef _STREAMS_GEN_LOAD_STORE_FOR
+
+/* Copy count items of item_size bytes (1, 2, 4 or 8) from src to dst
+ * reversing bytes of every item. Uses SSSE3/AVX2 when cpu supports them. dst
+ * may be equal to src for items bigger than 1 byte. */
+void _streams_copy_swapped(u8* dst, u8 const* src, u64 count, u64 item_size);
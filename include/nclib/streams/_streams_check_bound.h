@@ -14,8 +14,29 @@
               _stream_->_offset + _offset_diff_);                             \
     }
 
+#undef STREAM_CHECK_BOUND_AT
+
+#define STREAM_CHECK_BOUND_AT(_stream_, _offset_, _size_)                     \
+    if (_offset_ > _stream_->_size or _size_ > _stream_->_size - _offset_) {  \
+        panic("Error: stream access out of bound at %s:%d. Size=%lu, access " \
+              "by index=%lu.\n",                                              \
+              __FILE__, __LINE__, _stream_->_size, _offset_ + _size_);        \
+    }
+
+#undef BIT_STREAM_CHECK_BOUND
+
+#define BIT_STREAM_CHECK_BOUND(_stream_, _bits_diff_)                         \
+    if (_stream_->_bit_offset + _bits_diff_ > _stream_->_size * 8) {          \
+        panic("Error: bit stream access out of bound at %s:%d. Size=%lu "     \
+              "bits, access by bit index=%lu.\n",                             \
+              __FILE__, __LINE__, _stream_->_size * 8,                        \
+              _stream_->_bit_offset + _bits_diff_);                           \
+    }
+
 #else
 
 #define STREAM_CHECK_BOUND(_stream_, _offset_diff_)
+#define STREAM_CHECK_BOUND_AT(_stream_, _offset_, _size_)
+#define BIT_STREAM_CHECK_BOUND(_stream_, _bits_diff_)
 
 #endif // endif !CHECK_BOUND
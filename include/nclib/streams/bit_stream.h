@@ -0,0 +1,123 @@
+#pragma once
+
+#include "_streams_bswap.h"
+#include "_streams_check_bound.h"
+#include "bit_stream_order.h"
+#include "nclib/typedefs.h"
+
+/* Max count of bits which can be peeked at once, reads can take 57 bits. */
+#define BIT_STREAM_MAX_PEEK_BITS 56
+#define BIT_STREAM_MAX_READ_BITS 57
+
+/* Reader of bit fields. Bits are kept in 64 bit buffer which is refilled by
+ * one unaligned load, so after refill it always contains at least 56 bits.
+ * Bits after end of buffer are read as zeros. */
+typedef struct {
+    u8 const* _buf;
+    u64 _size;
+    u64 _offset;
+    u64 _bit_offset;
+    u64 _bits;
+    u32 _count;
+    BitStreamOrder _order;
+} BitStream;
+
+BitStream bit_stream_new(u8 const* buf, u64 size, BitStreamOrder order);
+BitStream bit_stream_new_msb(u8 const* buf, u64 size);
+BitStream bit_stream_new_lsb(u8 const* buf, u64 size);
+
+void bit_stream_skip_bits(BitStream* stream, u64 count);
+void bit_stream_align(BitStream* stream);
+
+void _bit_stream_refill_slow(BitStream* stream);
+
+[[maybe_unused]] static inline u64 bit_stream_tell(BitStream const* stream)
+{
+    return stream->_bit_offset;
+}
+
+[[maybe_unused]] static inline u64 bit_stream_size(BitStream const* stream)
+{
+    return stream->_size * 8;
+}
+
+[[maybe_unused]] static inline void _bit_stream_refill(BitStream* stream)
+{
+    if (stream->_offset + 8 > stream->_size) {
+        _bit_stream_refill_slow(stream);
+        return;
+    }
+
+    // Bytes which don't fit whole are loaded again by next refill.
+    u8 const* src = stream->_buf + stream->_offset;
+    if (stream->_order == BIT_STREAM_LSB_FIRST) {
+        stream->_bits |= _streams_load_u64(src, STREAM_LITTLE_ENDIAN)
+            << stream->_count;
+    }
+    else {
+        stream->_bits
+            |= _streams_load_u64(src, STREAM_BIG_ENDIAN) >> stream->_count;
+    }
+    stream->_offset += (63 - stream->_count) >> 3;
+    stream->_count |= 56;
+}
+
+[[maybe_unused]] static inline u64 _bit_stream_peek(BitStream const* stream,
+                                                    u32 count)
+{
+    if (stream->_order == BIT_STREAM_LSB_FIRST) {
+        return stream->_bits & (((u64)1 << count) - 1);
+    }
+    return (stream->_bits >> 1) >> (63 - count);
+}
+
+[[maybe_unused]] static inline void _bit_stream_consume(BitStream* stream,
+                                                        u32 count)
+{
+    BIT_STREAM_CHECK_BOUND(stream, count);
+
+    if (stream->_order == BIT_STREAM_LSB_FIRST) {
+        stream->_bits >>= count;
+    }
+    else {
+        stream->_bits <<= count;
+    }
+    stream->_count -= count;
+    stream->_bit_offset += count;
+}
+
+/* Return next `count` (<= 56) bits without moving stream. */
+[[maybe_unused]] static inline u64 bit_stream_peek_bits(BitStream* stream,
+                                                        u32 count)
+{
+    _bit_stream_refill(stream);
+    return _bit_stream_peek(stream, count);
+}
+
+/* Read next `count` (<= 57) bits. First read bit is the most significant bit
+ * of result for MSB first order and the least significant one otherwise. */
+[[maybe_unused]] static inline u64 bit_stream_read_bits(BitStream* stream,
+                                                        u32 count)
+{
+    // Refill guarantees only 56 bits, so longer fields are read by halves.
+    if (count > BIT_STREAM_MAX_PEEK_BITS) {
+        u64 first = bit_stream_read_bits(stream, 32);
+        u64 second = bit_stream_read_bits(stream, count - 32);
+
+        if (stream->_order == BIT_STREAM_LSB_FIRST) {
+            return first | second << 32;
+        }
+        return first << (count - 32) | second;
+    }
+
+    _bit_stream_refill(stream);
+    u64 bits = _bit_stream_peek(stream, count);
+    _bit_stream_consume(stream, count);
+
+    return bits;
+}
+
+[[maybe_unused]] static inline bool bit_stream_read_bit(BitStream* stream)
+{
+    return bit_stream_read_bits(stream, 1) != 0;
+}
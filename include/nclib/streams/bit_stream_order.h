@@ -0,0 +1,6 @@
+#pragma once
+
+typedef enum {
+    BIT_STREAM_MSB_FIRST = 0,
+    BIT_STREAM_LSB_FIRST = 1,
+} BitStreamOrder;
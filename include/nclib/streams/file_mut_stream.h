@@ -0,0 +1,74 @@
+#pragma once
+
+#include "nclib/typedefs.h"
+#include "stream_endian.h"
+
+#define FILE_MUT_STREAM_DEFAULT_BUFFER_SIZE (64 * 1024)
+
+typedef struct FileMutStream FileMutStream;
+typedef void (*FileMutStreamWriteBytesFn)(FileMutStream*, u8 const*, u64);
+
+/* Buffered writer over file descriptor. Full buffer is flushed with writev
+ * together with payload which doesn't fit into it, so big payloads are never
+ * copied into buffer. */
+struct FileMutStream {
+    int _fd;
+    u8* _buf;
+    u64 _capacity;
+    u64 _size;
+    u64 _flushed;
+    StreamEndian _endian;
+
+    FileMutStreamWriteBytesFn _write_bytes_impl;
+};
+
+FileMutStream file_mut_stream_new(int fd, u64 buffer_size,
+                                  StreamEndian endian);
+FileMutStream file_mut_stream_new_be(int fd, u64 buffer_size);
+FileMutStream file_mut_stream_new_le(int fd, u64 buffer_size);
+void file_mut_stream_free(FileMutStream* stream);
+
+void file_mut_stream_write_u8(FileMutStream* stream, u8 num);
+void file_mut_stream_write_i8(FileMutStream* stream, i8 num);
+void file_mut_stream_write_u16(FileMutStream* stream, u16 num);
+void file_mut_stream_write_i16(FileMutStream* stream, i16 num);
+void file_mut_stream_write_u32(FileMutStream* stream, u32 num);
+void file_mut_stream_write_i32(FileMutStream* stream, i32 num);
+void file_mut_stream_write_u64(FileMutStream* stream, u64 num);
+void file_mut_stream_write_i64(FileMutStream* stream, i64 num);
+void file_mut_stream_write_f32(FileMutStream* stream, f32 num);
+void file_mut_stream_write_f64(FileMutStream* stream, f64 num);
+void file_mut_stream_write_bool(FileMutStream* stream, bool flag);
+void file_mut_stream_write_bytes(FileMutStream* stream, u8 const* buf,
+                                 u64 size);
+
+void file_mut_stream_write_u8_array(FileMutStream* stream, u8 const* src,
+                                    u64 count);
+void file_mut_stream_write_i8_array(FileMutStream* stream, i8 const* src,
+                                    u64 count);
+void file_mut_stream_write_u16_array(FileMutStream* stream, u16 const* src,
+                                     u64 count);
+void file_mut_stream_write_i16_array(FileMutStream* stream, i16 const* src,
+                                     u64 count);
+void file_mut_stream_write_u32_array(FileMutStream* stream, u32 const* src,
+                                     u64 count);
+void file_mut_stream_write_i32_array(FileMutStream* stream, i32 const* src,
+                                     u64 count);
+void file_mut_stream_write_u64_array(FileMutStream* stream, u64 const* src,
+                                     u64 count);
+void file_mut_stream_write_i64_array(FileMutStream* stream, i64 const* src,
+                                     u64 count);
+void file_mut_stream_write_f32_array(FileMutStream* stream, f32 const* src,
+                                     u64 count);
+void file_mut_stream_write_f64_array(FileMutStream* stream, f64 const* src,
+                                     u64 count);
+void file_mut_stream_write_bool_array(FileMutStream* stream, bool const* src,
+                                      u64 count);
+
+void file_mut_stream_flush(FileMutStream* stream);
+
+[[maybe_unused]] static inline u64
+file_mut_stream_tell(FileMutStream const* stream)
+{
+    return stream->_flushed + stream->_size;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "nclib/typedefs.h"
+#include "stream_endian.h"
+#include "stream_whence.h"
+
+#define FILE_STREAM_DEFAULT_WINDOW_SIZE (64 * 1024)
+
+typedef struct FileStream FileStream;
+typedef void (*FileStreamReadBytesFn)(FileStream*, u8*, u64);
+
+/* Buffered reader over file descriptor. Keeps fixed size window of file in
+ * memory and refills it when read crosses window edge. Reading begins at
+ * current position of fd, tell and seek use absolute file offsets and size
+ * is size of whole file. */
+struct FileStream {
+    int _fd;
+    u8* _window;
+    u64 _window_capacity;
+    u64 _window_size;
+    u64 _window_offset;
+    u64 _window_start;
+    u64 _size;
+    StreamEndian _endian;
+
+    FileStreamReadBytesFn _read_bytes_impl;
+};
+
+FileStream file_stream_new(int fd, u64 window_size, StreamEndian endian);
+FileStream file_stream_new_be(int fd, u64 window_size);
+FileStream file_stream_new_le(int fd, u64 window_size);
+void file_stream_free(FileStream* stream);
+
+u8 file_stream_read_u8(FileStream* stream);
+i8 file_stream_read_i8(FileStream* stream);
+u16 file_stream_read_u16(FileStream* stream);
+i16 file_stream_read_i16(FileStream* stream);
+u32 file_stream_read_u32(FileStream* stream);
+i32 file_stream_read_i32(FileStream* stream);
+u64 file_stream_read_u64(FileStream* stream);
+i64 file_stream_read_i64(FileStream* stream);
+f32 file_stream_read_f32(FileStream* stream);
+f64 file_stream_read_f64(FileStream* stream);
+bool file_stream_read_bool(FileStream* stream);
+void file_stream_read_bytes(FileStream* stream, u8* buf, u64 size);
+
+void file_stream_read_u8_array(FileStream* stream, u8* dst, u64 count);
+void file_stream_read_i8_array(FileStream* stream, i8* dst, u64 count);
+void file_stream_read_u16_array(FileStream* stream, u16* dst, u64 count);
+void file_stream_read_i16_array(FileStream* stream, i16* dst, u64 count);
+void file_stream_read_u32_array(FileStream* stream, u32* dst, u64 count);
+void file_stream_read_i32_array(FileStream* stream, i32* dst, u64 count);
+void file_stream_read_u64_array(FileStream* stream, u64* dst, u64 count);
+void file_stream_read_i64_array(FileStream* stream, i64* dst, u64 count);
+void file_stream_read_f32_array(FileStream* stream, f32* dst, u64 count);
+void file_stream_read_f64_array(FileStream* stream, f64* dst, u64 count);
+void file_stream_read_bool_array(FileStream* stream, bool* dst, u64 count);
+
+u64 file_stream_seek(FileStream* stream, i64 offset, StreamWhence whence);
+
+[[maybe_unused]] static inline u64 file_stream_tell(FileStream const* stream)
+{
+    return stream->_window_start + stream->_window_offset;
+}
+
+[[maybe_unused]] static inline u64 file_stream_size(FileStream const* stream)
+{
+    return stream->_size;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "_streams_bswap.h"
+#include "_streams_check_bound.h"
+#include "bit_stream_order.h"
+#include "nclib/typedefs.h"
+
+#define MUT_BIT_STREAM_MAX_WRITE_BITS 57
+
+/* Writer of bit fields. Bits are collected in 64 bit buffer, whole bytes of
+ * it are stored by one unaligned store. Call mut_bit_stream_flush after last
+ * write to store incomplete byte (padded by zero bits). */
+typedef struct {
+    u8* _buf;
+    u64 _size;
+    u64 _offset;
+    u64 _bits;
+    u32 _count;
+    BitStreamOrder _order;
+} MutBitStream;
+
+MutBitStream mut_bit_stream_new(u8* buf, u64 size, BitStreamOrder order);
+MutBitStream mut_bit_stream_new_msb(u8* buf, u64 size);
+MutBitStream mut_bit_stream_new_lsb(u8* buf, u64 size);
+
+void mut_bit_stream_flush(MutBitStream* stream);
+
+void _mut_bit_stream_store_slow(MutBitStream* stream);
+
+[[maybe_unused]] static inline u64
+mut_bit_stream_tell(MutBitStream const* stream)
+{
+    return stream->_offset * 8 + stream->_count;
+}
+
+[[maybe_unused]] static inline u64
+mut_bit_stream_size(MutBitStream const* stream)
+{
+    return stream->_size * 8;
+}
+
+[[maybe_unused]] static inline void
+_mut_bit_stream_store(MutBitStream* stream)
+{
+    if (stream->_offset + 8 > stream->_size) {
+        _mut_bit_stream_store_slow(stream);
+        return;
+    }
+
+    // Incomplete byte is stored too, next store overwrites it.
+    u8* dst = stream->_buf + stream->_offset;
+    u32 shift = (stream->_count >> 3) * 4;
+
+    if (stream->_order == BIT_STREAM_LSB_FIRST) {
+        _streams_store_u64(dst, stream->_bits, STREAM_LITTLE_ENDIAN);
+        stream->_bits = (stream->_bits >> shift) >> shift;
+    }
+    else {
+        _streams_store_u64(dst, stream->_bits, STREAM_BIG_ENDIAN);
+        stream->_bits = (stream->_bits << shift) << shift;
+    }
+    stream->_offset += stream->_count >> 3;
+    stream->_count &= 7;
+}
+
+/* Write low `count` (<= 57) bits of `bits`. */
+[[maybe_unused]] static inline void
+mut_bit_stream_write_bits(MutBitStream* stream, u64 bits, u32 count)
+{
+    bits &= ((u64)1 << count) - 1;
+
+    if (stream->_order == BIT_STREAM_LSB_FIRST) {
+        stream->_bits |= bits << stream->_count;
+    }
+    else {
+        stream->_bits |= ((bits << (63 - count)) << 1) >> stream->_count;
+    }
+    stream->_count += count;
+
+    _mut_bit_stream_store(stream);
+}
+
+[[maybe_unused]] static inline void
+mut_bit_stream_write_bit(MutBitStream* stream, bool bit)
+{
+    mut_bit_stream_write_bits(stream, bit, 1);
+}
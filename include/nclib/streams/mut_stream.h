@@ -1,5 +1,7 @@
 #pragma once
 
+#include "_streams_bswap.h"
+#include "_streams_check_bound.h"
 #include "nclib/typedefs.h"
 #include "stream_endian.h"
 #include "stream_whence.h"
@@ -12,6 +14,9 @@ struct MutStream {
     u8* _buf;
     u64 _size;
     u64 _offset;
+    StreamEndian _endian;
+    u64 _capacity;
+    bool _growable;
 
     MutStreamReadBytesFn _read_bytes_impl;
     MutStreamWriteBytesFn _write_bytes_impl;
@@ -21,6 +26,14 @@ MutStream mut_stream_new(u8* buf, u64 size, StreamEndian endian);
 MutStream mut_stream_new_be(u8* buf, u64 size);
 MutStream mut_stream_new_le(u8* buf, u64 size);
 
+MutStream mut_stream_new_growable(u64 capacity, StreamEndian endian);
+MutStream mut_stream_new_growable_be(u64 capacity);
+MutStream mut_stream_new_growable_le(u64 capacity);
+
+void mut_stream_reserve(MutStream* stream, u64 size);
+u8* mut_stream_take(MutStream* stream, u64* size);
+void mut_stream_free(MutStream* stream);
+
 u8 mut_stream_read_u8(MutStream* stream);
 i8 mut_stream_read_i8(MutStream* stream);
 u16 mut_stream_read_u16(MutStream* stream);
@@ -34,6 +47,18 @@ f64 mut_stream_read_f64(MutStream* stream);
 bool mut_stream_read_bool(MutStream* stream);
 void mut_stream_read_bytes(MutStream* stream, u8* buf, u64 size);
 
+void mut_stream_read_u8_array(MutStream* stream, u8* dst, u64 count);
+void mut_stream_read_i8_array(MutStream* stream, i8* dst, u64 count);
+void mut_stream_read_u16_array(MutStream* stream, u16* dst, u64 count);
+void mut_stream_read_i16_array(MutStream* stream, i16* dst, u64 count);
+void mut_stream_read_u32_array(MutStream* stream, u32* dst, u64 count);
+void mut_stream_read_i32_array(MutStream* stream, i32* dst, u64 count);
+void mut_stream_read_u64_array(MutStream* stream, u64* dst, u64 count);
+void mut_stream_read_i64_array(MutStream* stream, i64* dst, u64 count);
+void mut_stream_read_f32_array(MutStream* stream, f32* dst, u64 count);
+void mut_stream_read_f64_array(MutStream* stream, f64* dst, u64 count);
+void mut_stream_read_bool_array(MutStream* stream, bool* dst, u64 count);
+
 void mut_stream_write_u8(MutStream* stream, u8 num);
 void mut_stream_write_i8(MutStream* stream, i8 num);
 void mut_stream_write_u16(MutStream* stream, u16 num);
@@ -47,6 +72,22 @@ void mut_stream_write_f64(MutStream* stream, f64 num);
 void mut_stream_write_bool(MutStream* stream, bool flag);
 void mut_stream_write_bytes(MutStream* stream, u8 const* buf, u64 size);
 
+void mut_stream_write_varint_u64(MutStream* stream, u64 num);
+void mut_stream_write_varint_i64(MutStream* stream, i64 num);
+
+void mut_stream_write_u8_array(MutStream* stream, u8 const* src, u64 count);
+void mut_stream_write_i8_array(MutStream* stream, i8 const* src, u64 count);
+void mut_stream_write_u16_array(MutStream* stream, u16 const* src, u64 count);
+void mut_stream_write_i16_array(MutStream* stream, i16 const* src, u64 count);
+void mut_stream_write_u32_array(MutStream* stream, u32 const* src, u64 count);
+void mut_stream_write_i32_array(MutStream* stream, i32 const* src, u64 count);
+void mut_stream_write_u64_array(MutStream* stream, u64 const* src, u64 count);
+void mut_stream_write_i64_array(MutStream* stream, i64 const* src, u64 count);
+void mut_stream_write_f32_array(MutStream* stream, f32 const* src, u64 count);
+void mut_stream_write_f64_array(MutStream* stream, f64 const* src, u64 count);
+void mut_stream_write_bool_array(MutStream* stream, bool const* src,
+                                 u64 count);
+
 u64 mut_stream_seek(MutStream* stream, i64 offset, StreamWhence whence);
 
 [[maybe_unused]] static inline u64 mut_stream_tell(MutStream const* stream)
@@ -64,3 +105,86 @@ mut_stream_raw(MutStream const* stream)
 {
     return stream->_buf;
 }
+
+[[maybe_unused]] static inline u64
+mut_stream_capacity(MutStream const* stream)
+{
+    return stream->_capacity;
+}
+
+/* Grow buffer of growable stream or check bound of fixed stream before
+ * writing `size` bytes at current offset. */
+void _mut_stream_extend(MutStream* stream, u64 size);
+
+[[maybe_unused]] static inline void
+_mut_stream_prepare_write(MutStream* stream, u64 size)
+{
+    if (stream->_offset + size > stream->_size) {
+        _mut_stream_extend(stream, size);
+    }
+}
+
+/* Inline methods with fixed endian. They don't use _read_bytes_impl and
+ * _write_bytes_impl, so they compile down to single load or store plus bswap
+ * (if endian differs from machine). */
+
+#define GEN_INLINE_READ_METHOD_FOR(_type_, _suffix_, _endian_)               \
+    [[maybe_unused]] static inline _type_                                     \
+        mut_stream_read_##_type_##_##_suffix_(MutStream* stream)              \
+    {                                                                         \
+        STREAM_CHECK_BOUND(stream, sizeof(_type_));                           \
+        _type_ num = _streams_load_##_type_(stream->_buf + stream->_offset,  \
+                                            _endian_);                        \
+        stream->_offset += sizeof(_type_);                                    \
+        return num;                                                           \
+    }
+
+#define GEN_INLINE_WRITE_METHOD_FOR(_type_, _suffix_, _endian_)              \
+    [[maybe_unused]] static inline void                                       \
+        mut_stream_write_##_type_##_##_suffix_(MutStream* stream,             \
+                                               _type_ num)                    \
+    {                                                                         \
+        _mut_stream_prepare_write(stream, sizeof(_type_));                    \
+        _streams_store_##_type_(stream->_buf + stream->_offset, num,          \
+                                _endian_);                                    \
+        stream->_offset += sizeof(_type_);                                    \
+    }
+
+GEN_INLINE_READ_METHOD_FOR(u16, le, STREAM_LITTLE_ENDIAN)
+GEN_INLINE_READ_METHOD_FOR(i16, le, STREAM_LITTLE_ENDIAN)
+GEN_INLINE_READ_METHOD_FOR(u32, le, STREAM_LITTLE_ENDIAN)
+GEN_INLINE_READ_METHOD_FOR(i32, le, STREAM_LITTLE_ENDIAN)
+GEN_INLINE_READ_METHOD_FOR(u64, le, STREAM_LITTLE_ENDIAN)
+GEN_INLINE_READ_METHOD_FOR(i64, le, STREAM_LITTLE_ENDIAN)
+GEN_INLINE_READ_METHOD_FOR(f32, le, STREAM_LITTLE_ENDIAN)
+GEN_INLINE_READ_METHOD_FOR(f64, le, STREAM_LITTLE_ENDIAN)
+
+GEN_INLINE_READ_METHOD_FOR(u16, be, STREAM_BIG_ENDIAN)
+GEN_INLINE_READ_METHOD_FOR(i16, be, STREAM_BIG_ENDIAN)
+GEN_INLINE_READ_METHOD_FOR(u32, be, STREAM_BIG_ENDIAN)
+GEN_INLINE_READ_METHOD_FOR(i32, be, STREAM_BIG_ENDIAN)
+GEN_INLINE_READ_METHOD_FOR(u64, be, STREAM_BIG_ENDIAN)
+GEN_INLINE_READ_METHOD_FOR(i64, be, STREAM_BIG_ENDIAN)
+GEN_INLINE_READ_METHOD_FOR(f32, be, STREAM_BIG_ENDIAN)
+GEN_INLINE_READ_METHOD_FOR(f64, be, STREAM_BIG_ENDIAN)
+
+GEN_INLINE_WRITE_METHOD_FOR(u16, le, STREAM_LITTLE_ENDIAN)
+GEN_INLINE_WRITE_METHOD_FOR(i16, le, STREAM_LITTLE_ENDIAN)
+GEN_INLINE_WRITE_METHOD_FOR(u32, le, STREAM_LITTLE_ENDIAN)
+GEN_INLINE_WRITE_METHOD_FOR(i32, le, STREAM_LITTLE_ENDIAN)
+GEN_INLINE_WRITE_METHOD_FOR(u64, le, STREAM_LITTLE_ENDIAN)
+GEN_INLINE_WRITE_METHOD_FOR(i64, le, STREAM_LITTLE_ENDIAN)
+GEN_INLINE_WRITE_METHOD_FOR(f32, le, STREAM_LITTLE_ENDIAN)
+GEN_INLINE_WRITE_METHOD_FOR(f64, le, STREAM_LITTLE_ENDIAN)
+
+GEN_INLINE_WRITE_METHOD_FOR(u16, be, STREAM_BIG_ENDIAN)
+GEN_INLINE_WRITE_METHOD_FOR(i16, be, STREAM_BIG_ENDIAN)
+GEN_INLINE_WRITE_METHOD_FOR(u32, be, STREAM_BIG_ENDIAN)
+GEN_INLINE_WRITE_METHOD_FOR(i32, be, STREAM_BIG_ENDIAN)
+GEN_INLINE_WRITE_METHOD_FOR(u64, be, STREAM_BIG_ENDIAN)
+GEN_INLINE_WRITE_METHOD_FOR(i64, be, STREAM_BIG_ENDIAN)
+GEN_INLINE_WRITE_METHOD_FOR(f32, be, STREAM_BIG_ENDIAN)
+GEN_INLINE_WRITE_METHOD_FOR(f64, be, STREAM_BIG_ENDIAN)
+
+#undef GEN_INLINE_READ_METHOD_FOR
+#undef GEN_INLINE_WRITE_METHOD_FOR
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <stdatomic.h>
+
+#include "mut_stream.h"
+#include "nclib/typedefs.h"
+#include "stream.h"
+#include "stream_endian.h"
+
+#define RING_STREAM_CACHE_LINE 64
+
+/* Single producer single consumer ring of messages. Producer writes message
+ * through MutStream over free space of ring and publishes it by one commit,
+ * consumer reads it through Stream and frees its space by commit. Every
+ * message is contiguous, so typed reads and writes don't care about wrap.
+ *
+ * Head is written only by producer and tail only by consumer, each one sits
+ * on own cache line next to private state of its side. Sides keep cached
+ * copy of other index, so shared line is read only when cached copy says
+ * that ring is full (or empty). */
+typedef struct {
+    _Alignas(RING_STREAM_CACHE_LINE) _Atomic(u64) _head;
+    u64 _write_pos;
+    u64 _cached_tail;
+
+    _Alignas(RING_STREAM_CACHE_LINE) _Atomic(u64) _tail;
+    u64 _read_pos;
+    u64 _cached_head;
+
+    _Alignas(RING_STREAM_CACHE_LINE) u8* _buf;
+    u64 _capacity;
+    StreamEndian _endian;
+} RingStream;
+
+/* Capacity must be power of two. Message with its 4 bytes header (aligned
+ * by 8) takes at most half of capacity. */
+RingStream ring_stream_new(u64 capacity, StreamEndian endian);
+RingStream ring_stream_new_be(u64 capacity);
+RingStream ring_stream_new_le(u64 capacity);
+void ring_stream_free(RingStream* ring);
+
+/* Producer. Begin gives stream over `max_size` free bytes or returns false
+ * when ring has no room, commit publishes bytes written to message. */
+bool ring_stream_try_write_begin(RingStream* ring, u64 max_size,
+                                 MutStream* message);
+void ring_stream_write_commit(RingStream* ring, MutStream const* message);
+
+/* Consumer. Begin gives stream over next message or returns false when ring
+ * is empty. Messages stay valid until commit, which frees space of every
+ * message read before it. */
+bool ring_stream_try_read_begin(RingStream* ring, Stream* message);
+void ring_stream_read_commit(RingStream* ring);
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <string.h>
+
+#include "_streams_bswap.h"
+#include "_streams_check_bound.h"
 #include "nclib/typedefs.h"
 #include "stream_endian.h"
 #include "stream_whence.h"
@@ -11,14 +15,30 @@ struct Stream {
     u8 const* _buf;
     u64 _size;
     u64 _offset;
+    StreamEndian _endian;
+    bool _fallible;
+    bool _error;
 
     StreamReadBytesFn _read_bytes_impl;
 };
 
+/* Borrowed bytes inside stream buffer. Valid while buffer is alive. */
+typedef struct {
+    u8 const* ptr;
+    u64 size;
+} StreamView;
+
 Stream stream_new(u8 const* buf, u64 size, StreamEndian endian);
 Stream stream_new_be(u8 const* buf, u64 size);
 Stream stream_new_le(u8 const* buf, u64 size);
 
+/* Fallible stream never panics and never reads out of buffer. Read past the
+ * end returns zeros, moves stream to the end and sets sticky error flag, so
+ * whole message is parsed without checks and flag is checked once after. */
+Stream stream_new_fallible(u8 const* buf, u64 size, StreamEndian endian);
+Stream stream_new_fallible_be(u8 const* buf, u64 size);
+Stream stream_new_fallible_le(u8 const* buf, u64 size);
+
 u8 stream_read_u8(Stream* stream);
 i8 stream_read_i8(Stream* stream);
 u16 stream_read_u16(Stream* stream);
@@ -31,6 +51,23 @@ f32 stream_read_f32(Stream* stream);
 f64 stream_read_f64(Stream* stream);
 bool stream_read_bool(Stream* stream);
 void stream_read_bytes(Stream* stream, u8* buf, u64 size);
+StreamView stream_read_view(Stream* stream, u64 size);
+Stream stream_substream(Stream* stream, u64 size);
+
+u64 stream_read_varint_u64(Stream* stream);
+i64 stream_read_varint_i64(Stream* stream);
+
+void stream_read_u8_array(Stream* stream, u8* dst, u64 count);
+void stream_read_i8_array(Stream* stream, i8* dst, u64 count);
+void stream_read_u16_array(Stream* stream, u16* dst, u64 count);
+void stream_read_i16_array(Stream* stream, i16* dst, u64 count);
+void stream_read_u32_array(Stream* stream, u32* dst, u64 count);
+void stream_read_i32_array(Stream* stream, i32* dst, u64 count);
+void stream_read_u64_array(Stream* stream, u64* dst, u64 count);
+void stream_read_i64_array(Stream* stream, i64* dst, u64 count);
+void stream_read_f32_array(Stream* stream, f32* dst, u64 count);
+void stream_read_f64_array(Stream* stream, f64* dst, u64 count);
+void stream_read_bool_array(Stream* stream, bool* dst, u64 count);
 
 u64 stream_seek(Stream* stream, i64 offset, StreamWhence whence);
 
@@ -48,3 +85,195 @@ u64 stream_seek(Stream* stream, i64 offset, StreamWhence whence);
 {
     return stream->_buf;
 }
+
+[[maybe_unused]] static inline bool stream_is_fallible(Stream const* stream)
+{
+    return stream->_fallible;
+}
+
+[[maybe_unused]] static inline bool stream_has_error(Stream const* stream)
+{
+    return stream->_error;
+}
+
+[[maybe_unused]] static inline void stream_clear_error(Stream* stream)
+{
+    stream->_error = false;
+}
+
+/* Returns true if fallible stream has less than `size` bytes left, then
+ * stream is moved to the end and error flag is set. Plain stream never takes
+ * this branch, so it costs one well predicted compare. */
+[[maybe_unused]] static inline bool _stream_out_of_bound(Stream* stream,
+                                                         u64 size)
+{
+    if (stream->_fallible and size > stream->_size - stream->_offset) {
+        stream->_offset = stream->_size;
+        stream->_error = true;
+        return true;
+    }
+
+    return false;
+}
+
+/* Inline methods with fixed endian. They don't use _read_bytes_impl, so they
+ * compile down to single load plus bswap (if endian differs from machine).
+ * Fallible stream returns 0 on short read. */
+
+#define GEN_INLINE_READ_METHOD_FOR(_type_, _suffix_, _endian_)                \
+    [[maybe_unused]] static inline _type_ stream_read_##_type_##_##_suffix_(  \
+        Stream* stream)                                                       \
+    {                                                                         \
+        if (_stream_out_of_bound(stream, sizeof(_type_))) {                   \
+            return 0;                                                         \
+        }                                                                     \
+        STREAM_CHECK_BOUND(stream, sizeof(_type_));                           \
+        _type_ num = _streams_load_##_type_(stream->_buf + stream->_offset,   \
+                                            _endian_);                        \
+        stream->_offset += sizeof(_type_);                                    \
+        return num;                                                           \
+    }
+
+GEN_INLINE_READ_METHOD_FOR(u16, le, STREAM_LITTLE_ENDIAN)
+GEN_INLINE_READ_METHOD_FOR(i16, le, STREAM_LITTLE_ENDIAN)
+GEN_INLINE_READ_METHOD_FOR(u32, le, STREAM_LITTLE_ENDIAN)
+GEN_INLINE_READ_METHOD_FOR(i32, le, STREAM_LITTLE_ENDIAN)
+GEN_INLINE_READ_METHOD_FOR(u64, le, STREAM_LITTLE_ENDIAN)
+GEN_INLINE_READ_METHOD_FOR(i64, le, STREAM_LITTLE_ENDIAN)
+GEN_INLINE_READ_METHOD_FOR(f32, le, STREAM_LITTLE_ENDIAN)
+GEN_INLINE_READ_METHOD_FOR(f64, le, STREAM_LITTLE_ENDIAN)
+
+GEN_INLINE_READ_METHOD_FOR(u16, be, STREAM_BIG_ENDIAN)
+GEN_INLINE_READ_METHOD_FOR(i16, be, STREAM_BIG_ENDIAN)
+GEN_INLINE_READ_METHOD_FOR(u32, be, STREAM_BIG_ENDIAN)
+GEN_INLINE_READ_METHOD_FOR(i32, be, STREAM_BIG_ENDIAN)
+GEN_INLINE_READ_METHOD_FOR(u64, be, STREAM_BIG_ENDIAN)
+GEN_INLINE_READ_METHOD_FOR(i64, be, STREAM_BIG_ENDIAN)
+GEN_INLINE_READ_METHOD_FOR(f32, be, STREAM_BIG_ENDIAN)
+GEN_INLINE_READ_METHOD_FOR(f64, be, STREAM_BIG_ENDIAN)
+
+#undef GEN_INLINE_READ_METHOD_FOR
+
+/* Check once that `size` bytes remain, then read them by _unchecked methods
+ * which never check bound (even with CHECK_BOUND option or fallible stream).
+ * Each of them is single load plus bswap if endian differs from machine. */
+[[maybe_unused]] static inline bool stream_ensure(Stream const* stream,
+                                                  u64 size)
+{
+    return stream->_offset <= stream->_size
+        and size <= stream->_size - stream->_offset;
+}
+
+#define GEN_INLINE_UNCHECKED_READ_METHOD_FOR(_type_, _suffix_, _endian_)      \
+    [[maybe_unused]] static inline _type_                                     \
+        stream_read_##_type_##_suffix_##unchecked(Stream* stream)             \
+    {                                                                         \
+        _type_ num = _streams_load_##_type_(stream->_buf + stream->_offset,   \
+                                            _endian_);                        \
+        stream->_offset += sizeof(_type_);                                    \
+        return num;                                                           \
+    }
+
+GEN_INLINE_UNCHECKED_READ_METHOD_FOR(u8, _, stream->_endian)
+GEN_INLINE_UNCHECKED_READ_METHOD_FOR(i8, _, stream->_endian)
+GEN_INLINE_UNCHECKED_READ_METHOD_FOR(u16, _, stream->_endian)
+GEN_INLINE_UNCHECKED_READ_METHOD_FOR(i16, _, stream->_endian)
+GEN_INLINE_UNCHECKED_READ_METHOD_FOR(u32, _, stream->_endian)
+GEN_INLINE_UNCHECKED_READ_METHOD_FOR(i32, _, stream->_endian)
+GEN_INLINE_UNCHECKED_READ_METHOD_FOR(u64, _, stream->_endian)
+GEN_INLINE_UNCHECKED_READ_METHOD_FOR(i64, _, stream->_endian)
+GEN_INLINE_UNCHECKED_READ_METHOD_FOR(f32, _, stream->_endian)
+GEN_INLINE_UNCHECKED_READ_METHOD_FOR(f64, _, stream->_endian)
+GEN_INLINE_UNCHECKED_READ_METHOD_FOR(bool, _, stream->_endian)
+
+GEN_INLINE_UNCHECKED_READ_METHOD_FOR(u16, _le_, STREAM_LITTLE_ENDIAN)
+GEN_INLINE_UNCHECKED_READ_METHOD_FOR(i16, _le_, STREAM_LITTLE_ENDIAN)
+GEN_INLINE_UNCHECKED_READ_METHOD_FOR(u32, _le_, STREAM_LITTLE_ENDIAN)
+GEN_INLINE_UNCHECKED_READ_METHOD_FOR(i32, _le_, STREAM_LITTLE_ENDIAN)
+GEN_INLINE_UNCHECKED_READ_METHOD_FOR(u64, _le_, STREAM_LITTLE_ENDIAN)
+GEN_INLINE_UNCHECKED_READ_METHOD_FOR(i64, _le_, STREAM_LITTLE_ENDIAN)
+GEN_INLINE_UNCHECKED_READ_METHOD_FOR(f32, _le_, STREAM_LITTLE_ENDIAN)
+GEN_INLINE_UNCHECKED_READ_METHOD_FOR(f64, _le_, STREAM_LITTLE_ENDIAN)
+
+GEN_INLINE_UNCHECKED_READ_METHOD_FOR(u16, _be_, STREAM_BIG_ENDIAN)
+GEN_INLINE_UNCHECKED_READ_METHOD_FOR(i16, _be_, STREAM_BIG_ENDIAN)
+GEN_INLINE_UNCHECKED_READ_METHOD_FOR(u32, _be_, STREAM_BIG_ENDIAN)
+GEN_INLINE_UNCHECKED_READ_METHOD_FOR(i32, _be_, STREAM_BIG_ENDIAN)
+GEN_INLINE_UNCHECKED_READ_METHOD_FOR(u64, _be_, STREAM_BIG_ENDIAN)
+GEN_INLINE_UNCHECKED_READ_METHOD_FOR(i64, _be_, STREAM_BIG_ENDIAN)
+GEN_INLINE_UNCHECKED_READ_METHOD_FOR(f32, _be_, STREAM_BIG_ENDIAN)
+GEN_INLINE_UNCHECKED_READ_METHOD_FOR(f64, _be_, STREAM_BIG_ENDIAN)
+
+#undef GEN_INLINE_UNCHECKED_READ_METHOD_FOR
+
+[[maybe_unused]] static inline void
+stream_read_bytes_unchecked(Stream* stream, u8* bytes, u64 size)
+{
+    memcpy(bytes, stream->_buf + stream->_offset, size);
+    stream->_offset += size;
+}
+
+/* Positional methods read at `offset` from start of buffer and don't move
+ * stream, so many threads can read one const stream without locks. Fallible
+ * stream returns 0 (zeroes bytes) on out of bound read, its error flag is
+ * not set because stream is const. */
+[[maybe_unused]] static inline bool
+_stream_out_of_bound_at(Stream const* stream, u64 offset, u64 size)
+{
+    return stream->_fallible
+        and (offset > stream->_size or size > stream->_size - offset);
+}
+
+#define GEN_INLINE_READ_AT_METHOD_FOR(_type_, _suffix_, _endian_)             \
+    [[maybe_unused]] static inline _type_                                     \
+        stream_read_##_type_##_suffix_##at(Stream const* stream, u64 offset)  \
+    {                                                                         \
+        if (_stream_out_of_bound_at(stream, offset, sizeof(_type_))) {        \
+            return 0;                                                         \
+        }                                                                     \
+        STREAM_CHECK_BOUND_AT(stream, offset, sizeof(_type_));                \
+        return _streams_load_##_type_(stream->_buf + offset, _endian_);       \
+    }
+
+GEN_INLINE_READ_AT_METHOD_FOR(u8, _, stream->_endian)
+GEN_INLINE_READ_AT_METHOD_FOR(i8, _, stream->_endian)
+GEN_INLINE_READ_AT_METHOD_FOR(u16, _, stream->_endian)
+GEN_INLINE_READ_AT_METHOD_FOR(i16, _, stream->_endian)
+GEN_INLINE_READ_AT_METHOD_FOR(u32, _, stream->_endian)
+GEN_INLINE_READ_AT_METHOD_FOR(i32, _, stream->_endian)
+GEN_INLINE_READ_AT_METHOD_FOR(u64, _, stream->_endian)
+GEN_INLINE_READ_AT_METHOD_FOR(i64, _, stream->_endian)
+GEN_INLINE_READ_AT_METHOD_FOR(f32, _, stream->_endian)
+GEN_INLINE_READ_AT_METHOD_FOR(f64, _, stream->_endian)
+GEN_INLINE_READ_AT_METHOD_FOR(bool, _, stream->_endian)
+
+GEN_INLINE_READ_AT_METHOD_FOR(u16, _le_, STREAM_LITTLE_ENDIAN)
+GEN_INLINE_READ_AT_METHOD_FOR(i16, _le_, STREAM_LITTLE_ENDIAN)
+GEN_INLINE_READ_AT_METHOD_FOR(u32, _le_, STREAM_LITTLE_ENDIAN)
+GEN_INLINE_READ_AT_METHOD_FOR(i32, _le_, STREAM_LITTLE_ENDIAN)
+GEN_INLINE_READ_AT_METHOD_FOR(u64, _le_, STREAM_LITTLE_ENDIAN)
+GEN_INLINE_READ_AT_METHOD_FOR(i64, _le_, STREAM_LITTLE_ENDIAN)
+GEN_INLINE_READ_AT_METHOD_FOR(f32, _le_, STREAM_LITTLE_ENDIAN)
+GEN_INLINE_READ_AT_METHOD_FOR(f64, _le_, STREAM_LITTLE_ENDIAN)
+
+GEN_INLINE_READ_AT_METHOD_FOR(u16, _be_, STREAM_BIG_ENDIAN)
+GEN_INLINE_READ_AT_METHOD_FOR(i16, _be_, STREAM_BIG_ENDIAN)
+GEN_INLINE_READ_AT_METHOD_FOR(u32, _be_, STREAM_BIG_ENDIAN)
+GEN_INLINE_READ_AT_METHOD_FOR(i32, _be_, STREAM_BIG_ENDIAN)
+GEN_INLINE_READ_AT_METHOD_FOR(u64, _be_, STREAM_BIG_ENDIAN)
+GEN_INLINE_READ_AT_METHOD_FOR(i64, _be_, STREAM_BIG_ENDIAN)
+GEN_INLINE_READ_AT_METHOD_FOR(f32, _be_, STREAM_BIG_ENDIAN)
+GEN_INLINE_READ_AT_METHOD_FOR(f64, _be_, STREAM_BIG_ENDIAN)
+
+#undef GEN_INLINE_READ_AT_METHOD_FOR
+
+[[maybe_unused]] static inline void
+stream_read_bytes_at(Stream const* stream, u64 offset, u8* bytes, u64 size)
+{
+    if (_stream_out_of_bound_at(stream, offset, size)) {
+        memset(bytes, 0, size);
+        return;
+    }
+    STREAM_CHECK_BOUND_AT(stream, offset, size);
+    memcpy(bytes, stream->_buf + offset, size);
+}
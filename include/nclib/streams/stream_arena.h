@@ -0,0 +1,28 @@
+#pragma once
+
+#include "nclib/alloc/arena.h"
+#include "nclib/typedefs.h"
+#include "stream.h"
+
+/* Methods which decode fields straight into arena memory, so all fields of
+ * message live until arena is reset. Var methods read varint length prefix
+ * written by mut_stream_write_varint_u64. Size is checked before anything
+ * is allocated: plain stream panics if it is too short, fallible stream
+ * sets error and returns NULL (var methods return empty bytes and string
+ * with zero length). */
+
+u8* stream_read_bytes_arena(Stream* stream, Arena* arena, u64 size);
+u8* stream_read_varbytes_arena(Stream* stream, Arena* arena, u64* size);
+char* stream_read_varstr_arena(Stream* stream, Arena* arena, u64* len);
+
+u8* stream_read_u8_array_arena(Stream* stream, Arena* arena, u64 count);
+i8* stream_read_i8_array_arena(Stream* stream, Arena* arena, u64 count);
+u16* stream_read_u16_array_arena(Stream* stream, Arena* arena, u64 count);
+i16* stream_read_i16_array_arena(Stream* stream, Arena* arena, u64 count);
+u32* stream_read_u32_array_arena(Stream* stream, Arena* arena, u64 count);
+i32* stream_read_i32_array_arena(Stream* stream, Arena* arena, u64 count);
+u64* stream_read_u64_array_arena(Stream* stream, Arena* arena, u64 count);
+i64* stream_read_i64_array_arena(Stream* stream, Arena* arena, u64 count);
+f32* stream_read_f32_array_arena(Stream* stream, Arena* arena, u64 count);
+f64* stream_read_f64_array_arena(Stream* stream, Arena* arena, u64 count);
+bool* stream_read_bool_array_arena(Stream* stream, Arena* arena, u64 count);
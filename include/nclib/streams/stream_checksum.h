@@ -0,0 +1,26 @@
+#pragma once
+
+#include "mut_stream.h"
+#include "nclib/typedefs.h"
+#include "stream.h"
+
+/* Running CRC32C of stream region between begin and end markers. Update
+ * hashes bytes which were consumed (or produced) since previous update
+ * right from stream buffer, while they are still in cache, so checked frame
+ * doesn't need second pass over memory. Region covers every byte between
+ * markers, bytes behind update position (after seek back) are not hashed
+ * twice. */
+typedef struct {
+    u32 _crc;
+    u64 _offset;
+} StreamChecksum;
+
+StreamChecksum stream_checksum_begin(Stream const* stream);
+void stream_checksum_update(StreamChecksum* checksum, Stream const* stream);
+u32 stream_checksum_end(StreamChecksum* checksum, Stream const* stream);
+
+StreamChecksum mut_stream_checksum_begin(MutStream const* stream);
+void mut_stream_checksum_update(StreamChecksum* checksum,
+                                MutStream const* stream);
+u32 mut_stream_checksum_end(StreamChecksum* checksum,
+                            MutStream const* stream);
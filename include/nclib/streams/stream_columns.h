@@ -0,0 +1,36 @@
+#pragma once
+
+#include "mut_stream.h"
+#include "nclib/typedefs.h"
+#include "stream.h"
+
+/* Layout of fixed size record: sizes of its fields in order, every field is
+ * 1, 2, 4 or 8 bytes. On the wire fields go one by one without padding. */
+typedef struct {
+    u8 const* sizes;
+    u64 count;
+} StreamColumnsLayout;
+
+#define _STREAM_COLUMNS_FIELD_SIZE(_type_, _field_) sizeof(_type_),
+
+#define _STREAM_COLUMNS_SIZES(_fields_)                                       \
+    ((u8 const[]) { _fields_(_STREAM_COLUMNS_FIELD_SIZE) })
+
+/* Layout from the same X-macro list of (type, name) fields which is used by
+ * STREAM_RECORD_DEFINE. */
+#define STREAM_COLUMNS_LAYOUT(_fields_)                                       \
+    ((StreamColumnsLayout) {                                                  \
+        .sizes = _STREAM_COLUMNS_SIZES(_fields_),                             \
+        .count = sizeof _STREAM_COLUMNS_SIZES(_fields_),                      \
+    })
+
+u64 stream_columns_record_size(StreamColumnsLayout layout);
+
+/* Decode `count` records into separate column per field, columns[k] gets
+ * `count` items of layout.sizes[k] bytes with machine endian. */
+void stream_read_columns(Stream* stream, StreamColumnsLayout layout,
+                         void* const* columns, u64 count);
+
+/* Encode `count` records from separate column per field. */
+void mut_stream_write_columns(MutStream* stream, StreamColumnsLayout layout,
+                              void const* const* columns, u64 count);
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "mut_stream.h"
+#include "nclib/checksum/xxh32.h"
+#include "nclib/typedefs.h"
+#include "stream.h"
+
+// Acceleration of compressor, bigger is faster with worse ratio.
+#define STREAM_LZ4_ACCELERATION_DEFAULT 1
+#define STREAM_LZ4_ACCELERATION_FAST 8
+
+// Max size of block written by frame writer.
+#define STREAM_LZ4_FRAME_BLOCK_SIZE (64 * 1024)
+
+/* Compressor of LZ4 block format, compatible with reference LZ4. Block has
+ * no header, so its compressed and max decompressed sizes are stored by
+ * caller. Malformed data or too small output makes fallible stream error and
+ * panics otherwise. */
+
+u64 stream_lz4_compress_bound(u64 size);
+
+/* Compress `size` bytes into stream, returns compressed size. */
+u64 mut_stream_write_lz4_block(MutStream* stream, u8 const* src, u64 size,
+                               u32 acceleration);
+
+/* Decompress block of `compressed_size` bytes into `dst` at its offset.
+ * Growable `dst` grows up to `max_size` bytes, returns decompressed size. */
+u64 stream_read_lz4_block(Stream* stream, u64 compressed_size, MutStream* dst,
+                          u64 max_size);
+
+/* LZ4 frame format. Writer emits independent blocks up to
+ * STREAM_LZ4_FRAME_BLOCK_SIZE with content checksum. Reader accepts frames
+ * of reference LZ4 (any block size, linked blocks, block and content
+ * checksums, content size) except dictionaries, and decodes one block per
+ * call, so data is consumed chunk by chunk. */
+
+typedef struct {
+    u32 _acceleration;
+    Xxh32 _checksum;
+} Lz4FrameWriter;
+
+typedef struct {
+    u64 _block_max_size;
+    u64 _content_size;
+    u64 _produced;
+    u64 _history;
+    bool _linked;
+    bool _block_checksum;
+    bool _content_checksum;
+    bool _has_content_size;
+    bool _done;
+    Xxh32 _checksum;
+} Lz4FrameReader;
+
+Lz4FrameWriter mut_stream_lz4_frame_begin(MutStream* stream,
+                                          u32 acceleration);
+void mut_stream_lz4_frame_write(Lz4FrameWriter* writer, MutStream* stream,
+                                u8 const* src, u64 size);
+void mut_stream_lz4_frame_end(Lz4FrameWriter* writer, MutStream* stream);
+
+/* Read frame header. */
+Lz4FrameReader stream_lz4_frame_begin(Stream* stream);
+
+/* Decompress next block into `dst`, returns false after end of frame (its
+ * checksum is verified then). For linked blocks previous output must stay
+ * in `dst` right before its offset. */
+bool stream_lz4_frame_read_block(Lz4FrameReader* reader, Stream* stream,
+                                 MutStream* dst);
+
+/* Decompress whole frame into `dst`, returns decompressed size. */
+u64 stream_read_lz4_frame(Stream* stream, MutStream* dst);
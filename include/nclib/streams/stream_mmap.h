@@ -0,0 +1,25 @@
+#pragma once
+
+#include "mut_stream.h"
+#include "nclib/typedefs.h"
+#include "stream.h"
+#include "stream_endian.h"
+
+typedef enum {
+    STREAM_MMAP_DEFAULT = 0,
+    STREAM_MMAP_SEQUENTIAL = 1 << 0,
+    STREAM_MMAP_RANDOM = 1 << 1,
+    STREAM_MMAP_POPULATE = 1 << 2,
+} StreamMmapFlags;
+
+/* Map whole file for reading. Return false and keep errno on failure. */
+bool stream_open_mmap(Stream* stream, char const* path, StreamEndian endian,
+                      StreamMmapFlags flags);
+void stream_close_mmap(Stream* stream);
+
+/* Map file for reading and writing. File is created if needed and resized to
+ * `size` bytes, pass 0 to keep its current size. Return false and keep errno
+ * on failure. */
+bool mut_stream_open_mmap(MutStream* stream, char const* path, u64 size,
+                          StreamEndian endian, StreamMmapFlags flags);
+void mut_stream_close_mmap(MutStream* stream);
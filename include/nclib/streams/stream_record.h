@@ -0,0 +1,150 @@
+#pragma once
+
+#include <string.h>
+
+#include "_streams_bswap.h"
+#include "_streams_check_bound.h"
+#include "mut_stream.h"
+#include "nclib/typedefs.h"
+#include "stream.h"
+
+/* Record codec generated from list of fields. Fields are declared once by
+ * X-macro, which calls its argument with (type, name) for every field:
+ *
+ *     #define ADDR_FIELDS(X) X(i32, page_id) X(i16, offset)
+ *     STREAM_RECORD_DEFINE(Addr, addr, ADDR_FIELDS)
+ *
+ * Types are u8, i8, u16, i16, u32, i32, u64, i64, f32, f64 and bool. On the
+ * wire fields go one by one without padding. */
+
+#define _STREAM_RECORD_MEMBER(_type_, _field_) _type_ _field_;
+
+#define _STREAM_RECORD_SIZE(_type_, _field_) +sizeof(_type_)
+
+#define _STREAM_RECORD_LOAD(_type_, _field_)                                  \
+    dst->_field_ = _streams_load_##_type_(src, endian);                       \
+    src += sizeof(_type_);
+
+#define _STREAM_RECORD_STORE(_type_, _field_)                                 \
+    _streams_store_##_type_(dst, src->_field_, endian);                       \
+    dst += sizeof(_type_);
+
+/* Define struct `_name_` with fields from `_fields_` and methods:
+ *
+ *     u64 _prefix__wire_size(void);
+ *     _name_ stream_read__prefix_(Stream* stream);
+ *     void stream_read__prefix__array(Stream* stream, _name_* dst, u64 count);
+ *     void mut_stream_write__prefix_(MutStream* stream, _name_ record);
+ *     void mut_stream_write__prefix__array(MutStream* stream,
+ *                                          _name_ const* src, u64 count);
+ *
+ * Bound is checked once per call, not per field. If struct has no padding
+ * and stream endian is machine endian, records are copied by one memcpy.
+ * Otherwise every field is one load or store with constant offset plus
+ * bswap. */
+#define STREAM_RECORD_DEFINE(_name_, _prefix_, _fields_)                      \
+    typedef struct {                                                          \
+        _fields_(_STREAM_RECORD_MEMBER)                                       \
+    } _name_;                                                                 \
+                                                                              \
+    [[maybe_unused]] static inline u64 _prefix_##_wire_size(void)             \
+    {                                                                         \
+        return 0 _fields_(_STREAM_RECORD_SIZE);                               \
+    }                                                                         \
+                                                                              \
+    [[maybe_unused]] static inline void _##_prefix_##_decode(                 \
+        _name_* dst, u8 const* src, StreamEndian endian)                      \
+    {                                                                         \
+        _fields_(_STREAM_RECORD_LOAD)                                         \
+    }                                                                         \
+                                                                              \
+    [[maybe_unused]] static inline void _##_prefix_##_encode(                 \
+        u8* dst, _name_ const* src, StreamEndian endian)                      \
+    {                                                                         \
+        _fields_(_STREAM_RECORD_STORE)                                        \
+    }                                                                         \
+                                                                              \
+    [[maybe_unused]] static inline void _##_prefix_##_decode_array(           \
+        _name_* dst, u8 const* src, u64 count, StreamEndian endian)           \
+    {                                                                         \
+        u64 size = _prefix_##_wire_size();                                    \
+                                                                              \
+        if (sizeof(_name_) == size and endian == MACHINE_ENDIAN) {            \
+            memcpy(dst, src, count * size);                                   \
+        }                                                                     \
+        else if (endian == STREAM_LITTLE_ENDIAN) {                            \
+            for (u64 i = 0; i < count; ++i) {                                 \
+                _##_prefix_##_decode(dst + i, src + i * size,                 \
+                                     STREAM_LITTLE_ENDIAN);                   \
+            }                                                                 \
+        }                                                                     \
+        else {                                                                \
+            for (u64 i = 0; i < count; ++i) {                                 \
+                _##_prefix_##_decode(dst + i, src + i * size,                 \
+                                     STREAM_BIG_ENDIAN);                      \
+            }                                                                 \
+        }                                                                     \
+    }                                                                         \
+                                                                              \
+    [[maybe_unused]] static inline void _##_prefix_##_encode_array(           \
+        u8* dst, _name_ const* src, u64 count, StreamEndian endian)           \
+    {                                                                         \
+        u64 size = _prefix_##_wire_size();                                    \
+                                                                              \
+        if (sizeof(_name_) == size and endian == MACHINE_ENDIAN) {            \
+            memcpy(dst, src, count * size);                                   \
+        }                                                                     \
+        else if (endian == STREAM_LITTLE_ENDIAN) {                            \
+            for (u64 i = 0; i < count; ++i) {                                 \
+                _##_prefix_##_encode(dst + i * size, src + i,                 \
+                                     STREAM_LITTLE_ENDIAN);                   \
+            }                                                                 \
+        }                                                                     \
+        else {                                                                \
+            for (u64 i = 0; i < count; ++i) {                                 \
+                _##_prefix_##_encode(dst + i * size, src + i,                 \
+                                     STREAM_BIG_ENDIAN);                      \
+            }                                                                 \
+        }                                                                     \
+    }                                                                         \
+                                                                              \
+    [[maybe_unused]] static inline void stream_read_##_prefix_##_array(       \
+        Stream* stream, _name_* dst, u64 count)                               \
+    {                                                                         \
+        u64 size = count * _prefix_##_wire_size();                            \
+                                                                              \
+        if (_stream_out_of_bound(stream, size)) {                             \
+            memset(dst, 0, count * sizeof(_name_));                           \
+            return;                                                           \
+        }                                                                     \
+        STREAM_CHECK_BOUND(stream, size);                                     \
+                                                                              \
+        _##_prefix_##_decode_array(dst, stream->_buf + stream->_offset,       \
+                                   count, stream->_endian);                   \
+        stream->_offset += size;                                              \
+    }                                                                         \
+                                                                              \
+    [[maybe_unused]] static inline _name_ stream_read_##_prefix_(             \
+        Stream* stream)                                                       \
+    {                                                                         \
+        _name_ record;                                                        \
+        stream_read_##_prefix_##_array(stream, &record, 1);                   \
+        return record;                                                        \
+    }                                                                         \
+                                                                              \
+    [[maybe_unused]] static inline void mut_stream_write_##_prefix_##_array(  \
+        MutStream* stream, _name_ const* src, u64 count)                      \
+    {                                                                         \
+        u64 size = count * _prefix_##_wire_size();                            \
+                                                                              \
+        _mut_stream_prepare_write(stream, size);                              \
+        _##_prefix_##_encode_array(stream->_buf + stream->_offset, src,       \
+                                   count, stream->_endian);                   \
+        stream->_offset += size;                                              \
+    }                                                                         \
+                                                                              \
+    [[maybe_unused]] static inline void mut_stream_write_##_prefix_(          \
+        MutStream* stream, _name_ record)                                     \
+    {                                                                         \
+        mut_stream_write_##_prefix_##_array(stream, &record, 1);              \
+    }
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "mut_stream.h"
+#include "nclib/str/str.h"
+#include "nclib/typedefs.h"
+#include "stream.h"
+
+/* Strings prefixed by varint length, the same framing as var methods of
+ * stream_arena.h use, so string written here can be read by
+ * stream_read_varstr_arena. Chars aren't null terminated. */
+
+StrView stream_read_str_view(Stream* stream);
+Str stream_read_str(Stream* stream);
+void mut_stream_write_str_view(MutStream* stream, StrView view);
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "mut_stream.h"
+#include "nclib/typedefs.h"
+#include "stream.h"
+
+/* Stream VByte codec for u32 arrays. Encoded array is ceil(count / 4)
+ * control bytes (2 bits of byte length per number) followed by 1-4 little
+ * endian data bytes per number. Endian of stream isn't used. Count of numbers
+ * isn't stored, caller must save it. */
+
+u64 stream_vbyte_size_bound(u64 count);
+
+void stream_read_vbyte_u32_array(Stream* stream, u32* dst, u64 count);
+void stream_read_vbyte_u32_array_delta(Stream* stream, u32* dst, u64 count,
+                                       u32 prev);
+
+void mut_stream_write_vbyte_u32_array(MutStream* stream, u32 const* src,
+                                      u64 count);
+void mut_stream_write_vbyte_u32_array_delta(MutStream* stream, u32 const* src,
+                                            u64 count, u32 prev);
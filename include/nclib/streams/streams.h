@@ -1,6 +1,22 @@
 #pragma once
 
+#include "bit_stream.h"
+#include "mut_bit_stream.h"
 #include "mut_stream.h"
+#include "ring_stream.h"
 #include "stream.h"
+#include "stream_arena.h"
+#include "stream_checksum.h"
+#include "stream_columns.h"
 #include "stream_endian.h"
+#include "stream_lz4.h"
+#include "stream_record.h"
+#include "stream_str.h"
+#include "stream_vbyte.h"
 #include "stream_whence.h"
+
+#ifndef _WIN32
+#include "file_mut_stream.h"
+#include "file_stream.h"
+#include "stream_mmap.h"
+#endif
@@ -0,0 +1,185 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "nclib/alloc/arena.h"
+#include "nclib/panic.h"
+
+struct ArenaBlock {
+    ArenaBlock* _next;
+    u64 _capacity;
+    _Alignas(max_align_t) u8 _data[];
+};
+
+static _Thread_local Arena _arena_scratches[ARENA_SCRATCH_COUNT];
+
+/****************************************************************
+ *              PRIVATE METHODS SIGNATURE START.                *
+ ****************************************************************/
+
+static ArenaBlock* _arena_block_new(u64 capacity, ArenaBlock* next);
+static void _arena_use_block(Arena* arena, ArenaBlock* block);
+
+/************************************************************
+ *              PRIVATE METHODS SIGNATURE END.              *
+ ************************************************************/
+
+/****************************************************
+ *              PUBLIC METHODS START.               *
+ ****************************************************/
+
+Arena arena_new(u64 block_size)
+{
+    if (block_size == 0) {
+        block_size = ARENA_DEFAULT_BLOCK_SIZE;
+    }
+
+    // Blocks are allocated by first allocation, so empty arena is free.
+    return (Arena) {
+        ._first = NULL,
+        ._block = NULL,
+        ._ptr = NULL,
+        ._end = NULL,
+        ._block_size = block_size,
+    };
+}
+
+void arena_free(Arena* arena)
+{
+    ArenaBlock* block = arena->_first;
+
+    while (block != NULL) {
+        ArenaBlock* next = block->_next;
+        free(block);
+        block = next;
+    }
+
+    *arena = arena_new(arena->_block_size);
+}
+
+void* arena_alloc_zeroed(Arena* arena, u64 size)
+{
+    void* ptr = arena_alloc(arena, size);
+    memset(ptr, 0, size);
+    return ptr;
+}
+
+ArenaCheckpoint arena_save(Arena const* arena)
+{
+    return (ArenaCheckpoint) {
+        ._block = arena->_block,
+        ._ptr = arena->_ptr,
+    };
+}
+
+void arena_restore(Arena* arena, ArenaCheckpoint checkpoint)
+{
+    if (checkpoint._block == NULL) {
+        arena_reset(arena);
+        return;
+    }
+
+    _arena_use_block(arena, checkpoint._block);
+    arena->_ptr = checkpoint._ptr;
+}
+
+void arena_reset(Arena* arena)
+{
+    // Next allocation starts again from first block.
+    arena->_block = NULL;
+    arena->_ptr = NULL;
+    arena->_end = NULL;
+}
+
+ArenaScratch arena_scratch_begin(Arena* const* conflicts, u64 conflicts_count)
+{
+    // Pick scratch arena which isn't used by caller for result.
+    for (u64 i = 0; i < ARENA_SCRATCH_COUNT; ++i) {
+        Arena* scratch = &_arena_scratches[i];
+
+        bool conflict = false;
+        for (u64 j = 0; j < conflicts_count; ++j) {
+            conflict = conflict or conflicts[j] == scratch;
+        }
+        if (conflict) {
+            continue;
+        }
+
+        if (scratch->_block_size == 0) {
+            *scratch = arena_new(0);
+        }
+        return (ArenaScratch) {
+            .arena = scratch,
+            .checkpoint = arena_save(scratch),
+        };
+    }
+
+    panic("Error: all %d scratch arenas are in conflict.\n",
+          ARENA_SCRATCH_COUNT);
+}
+
+void arena_scratch_end(ArenaScratch scratch)
+{
+    arena_restore(scratch.arena, scratch.checkpoint);
+}
+
+void arena_scratch_free(void)
+{
+    for (u64 i = 0; i < ARENA_SCRATCH_COUNT; ++i) {
+        arena_free(&_arena_scratches[i]);
+    }
+}
+
+void* _arena_alloc_slow(Arena* arena, u64 size, u64 align)
+{
+    u64 needed = size + align - 1;
+    ArenaBlock* next
+        = arena->_block != NULL ? arena->_block->_next : arena->_first;
+
+    // Kept block is reused if it is big enough, otherwise new block is
+    // inserted before it and kept block waits for smaller allocations.
+    if (next == NULL or next->_capacity < needed) {
+        u64 capacity = needed > arena->_block_size ? needed : arena->_block_size;
+        next = _arena_block_new(capacity, next);
+
+        if (arena->_block != NULL) {
+            arena->_block->_next = next;
+        }
+        else {
+            arena->_first = next;
+        }
+    }
+
+    _arena_use_block(arena, next);
+    return arena_alloc_aligned(arena, size, align);
+}
+
+/****************************************************
+ *              PUBLIC METHODS END.                 *
+ ****************************************************/
+
+/****************************************************
+ *              PRIVATE METHODS START.              *
+ ****************************************************/
+
+static ArenaBlock* _arena_block_new(u64 capacity, ArenaBlock* next)
+{
+    ArenaBlock* block = malloc(sizeof(ArenaBlock) + capacity);
+    if (block == NULL) {
+        panic("Error: can't allocate %lu bytes for arena block.\n", capacity);
+    }
+
+    block->_next = next;
+    block->_capacity = capacity;
+    return block;
+}
+
+static void _arena_use_block(Arena* arena, ArenaBlock* block)
+{
+    arena->_block = block;
+    arena->_ptr = block->_data;
+    arena->_end = block->_data + block->_capacity;
+}
+
+/****************************************************
+ *              PRIVATE METHODS END.                *
+ ****************************************************/
@@ -0,0 +1,281 @@
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "nclib/alloc/pool.h"
+#include "nclib/panic.h"
+
+/********************************************
+ *              DEFINES START.              *
+ ********************************************/
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define POOL_SPIN_PAUSE() __builtin_ia32_pause()
+#else
+#define POOL_SPIN_PAUSE()
+#endif
+
+/********************************************
+ *              DEFINES END.                *
+ ********************************************/
+
+struct PoolSlab {
+    PoolSlab* _next;
+    _Alignas(max_align_t) u8 _data[];
+};
+
+/****************************************************************
+ *              PRIVATE METHODS SIGNATURE START.                *
+ ****************************************************************/
+
+static void _pool_lock(Pool* pool);
+static void _pool_unlock(Pool* pool);
+static PoolSlot* _pool_take(Pool* pool);
+static void _pool_add_in_use(Pool* pool, i64 delta);
+static void _pool_cache_sync(PoolCache* cache);
+static void _pool_slab_new(Pool* pool);
+
+/************************************************************
+ *              PRIVATE METHODS SIGNATURE END.              *
+ ************************************************************/
+
+/****************************************************
+ *              PUBLIC METHODS START.               *
+ ****************************************************/
+
+Pool pool_new(u64 slot_size, u64 slot_align, u64 slab_slots)
+{
+    if (slot_align == 0 or (slot_align & (slot_align - 1)) != 0) {
+        panic("Error: pool slot align %lu is not power of two.\n",
+              slot_align);
+    }
+    if (slab_slots == 0) {
+        slab_slots = POOL_DEFAULT_SLAB_SLOTS;
+    }
+
+    // Free slot holds pointer to next one.
+    if (slot_align < _Alignof(PoolSlot)) {
+        slot_align = _Alignof(PoolSlot);
+    }
+    if (slot_size < sizeof(PoolSlot)) {
+        slot_size = sizeof(PoolSlot);
+    }
+    slot_size = (slot_size + slot_align - 1) & ~(slot_align - 1);
+
+    // Slabs are allocated by first allocation, so empty pool is free.
+    return (Pool) {
+        ._free = NULL,
+        ._slabs = NULL,
+        ._ptr = NULL,
+        ._end = NULL,
+        ._slot_size = slot_size,
+        ._slot_align = slot_align,
+        ._slab_slots = slab_slots,
+        ._in_use = 0,
+        ._high_water = 0,
+        ._lock = ATOMIC_FLAG_INIT,
+    };
+}
+
+void pool_free(Pool* pool)
+{
+    PoolSlab* slab = pool->_slabs;
+
+    while (slab != NULL) {
+        PoolSlab* next = slab->_next;
+        free(slab);
+        slab = next;
+    }
+
+    *pool = pool_new(pool->_slot_size, pool->_slot_align, pool->_slab_slots);
+}
+
+void* pool_alloc(Pool* pool)
+{
+    _pool_lock(pool);
+    PoolSlot* slot = _pool_take(pool);
+    _pool_add_in_use(pool, 1);
+    _pool_unlock(pool);
+
+    return slot;
+}
+
+void pool_release(Pool* pool, void* ptr)
+{
+    PoolSlot* slot = ptr;
+
+    _pool_lock(pool);
+    slot->_next = pool->_free;
+    pool->_free = slot;
+    _pool_add_in_use(pool, -1);
+    _pool_unlock(pool);
+}
+
+u64 pool_in_use(Pool* pool)
+{
+    _pool_lock(pool);
+    i64 in_use = pool->_in_use;
+    _pool_unlock(pool);
+
+    // Slot allocated by one cache and released by another one is counted
+    // as negative until first cache syncs.
+    return in_use > 0 ? (u64)in_use : 0;
+}
+
+u64 pool_high_water(Pool* pool)
+{
+    _pool_lock(pool);
+    i64 high_water = pool->_high_water;
+    _pool_unlock(pool);
+
+    return (u64)high_water;
+}
+
+PoolCache pool_cache_new(Pool* pool)
+{
+    return (PoolCache) {
+        ._pool = pool,
+        ._free = NULL,
+        ._count = 0,
+        ._in_use = 0,
+        ._peak = 0,
+    };
+}
+
+void pool_cache_flush(PoolCache* cache)
+{
+    Pool* pool = cache->_pool;
+
+    _pool_lock(pool);
+    while (cache->_free != NULL) {
+        PoolSlot* slot = cache->_free;
+        cache->_free = slot->_next;
+        slot->_next = pool->_free;
+        pool->_free = slot;
+    }
+    _pool_cache_sync(cache);
+    _pool_unlock(pool);
+
+    cache->_count = 0;
+}
+
+void _pool_cache_refill(PoolCache* cache)
+{
+    Pool* pool = cache->_pool;
+
+    _pool_lock(pool);
+    for (u64 i = 0; i < POOL_CACHE_BATCH; ++i) {
+        PoolSlot* slot = _pool_take(pool);
+        slot->_next = cache->_free;
+        cache->_free = slot;
+    }
+    _pool_cache_sync(cache);
+    _pool_unlock(pool);
+
+    cache->_count += POOL_CACHE_BATCH;
+}
+
+void _pool_cache_drain(PoolCache* cache)
+{
+    Pool* pool = cache->_pool;
+
+    // Chain is cut before lock, so lock covers only splice.
+    PoolSlot* first = cache->_free;
+    PoolSlot* last = first;
+    for (u64 i = 1; i < POOL_CACHE_BATCH; ++i) {
+        last = last->_next;
+    }
+    cache->_free = last->_next;
+    cache->_count -= POOL_CACHE_BATCH;
+
+    _pool_lock(pool);
+    last->_next = pool->_free;
+    pool->_free = first;
+    _pool_cache_sync(cache);
+    _pool_unlock(pool);
+}
+
+/****************************************************
+ *              PUBLIC METHODS END.                 *
+ ****************************************************/
+
+/****************************************************
+ *              PRIVATE METHODS START.              *
+ ****************************************************/
+
+static void _pool_lock(Pool* pool)
+{
+    while (atomic_flag_test_and_set_explicit(&pool->_lock,
+                                             memory_order_acquire)) {
+        POOL_SPIN_PAUSE();
+    }
+}
+
+static void _pool_unlock(Pool* pool)
+{
+    atomic_flag_clear_explicit(&pool->_lock, memory_order_release);
+}
+
+/* Pop free slot or cut new one from slab, pool must be locked. */
+static PoolSlot* _pool_take(Pool* pool)
+{
+    PoolSlot* slot = pool->_free;
+
+    if (slot != NULL) {
+        pool->_free = slot->_next;
+        return slot;
+    }
+
+    if (pool->_ptr == pool->_end) {
+        _pool_slab_new(pool);
+    }
+    slot = (PoolSlot*)(void*)pool->_ptr;
+    pool->_ptr += pool->_slot_size;
+
+    return slot;
+}
+
+static void _pool_add_in_use(Pool* pool, i64 delta)
+{
+    pool->_in_use += delta;
+    if (pool->_in_use > pool->_high_water) {
+        pool->_high_water = pool->_in_use;
+    }
+}
+
+/* Add allocations counted by cache to pool, pool must be locked. */
+static void _pool_cache_sync(PoolCache* cache)
+{
+    Pool* pool = cache->_pool;
+
+    if (pool->_in_use + cache->_peak > pool->_high_water) {
+        pool->_high_water = pool->_in_use + cache->_peak;
+    }
+    pool->_in_use += cache->_in_use;
+
+    cache->_in_use = 0;
+    cache->_peak = 0;
+}
+
+static void _pool_slab_new(Pool* pool)
+{
+    u64 size = pool->_slab_slots * pool->_slot_size;
+    u64 padding = pool->_slot_align > _Alignof(max_align_t)
+                    ? pool->_slot_align
+                    : 0;
+
+    PoolSlab* slab = malloc(sizeof(PoolSlab) + size + padding);
+    if (slab == NULL) {
+        panic("Error: can't allocate %lu bytes for pool slab.\n", size);
+    }
+    slab->_next = pool->_slabs;
+    pool->_slabs = slab;
+
+    uintptr_t ptr = ((uintptr_t)slab->_data + (pool->_slot_align - 1))
+                  & ~(pool->_slot_align - 1);
+    pool->_ptr = (u8*)ptr;
+    pool->_end = pool->_ptr + size;
+}
+
+/****************************************************
+ *              PRIVATE METHODS END.                *
+ ****************************************************/
@@ -0,0 +1,162 @@
+#include <string.h>
+
+#include "nclib/checksum/xxh32.h"
+
+/********************************************
+ *              DEFINES START.              *
+ ********************************************/
+
+#define XXH32_PRIME1 0x9e3779b1u
+#define XXH32_PRIME2 0x85ebca77u
+#define XXH32_PRIME3 0xc2b2ae3du
+#define XXH32_PRIME4 0x27d4eb2fu
+#define XXH32_PRIME5 0x165667b1u
+
+/********************************************
+ *              DEFINES END.                *
+ ********************************************/
+
+/****************************************************************
+ *              PRIVATE METHODS SIGNATURE START.                *
+ ****************************************************************/
+
+static inline u32 _xxh32_rotl(u32 num, u32 bits);
+static inline u32 _xxh32_load(u8 const* src);
+static inline u32 _xxh32_round(u32 acc, u32 lane);
+static void _xxh32_stripe(u32* acc, u8 const* src);
+static u32 _xxh32_finish(u32 hash, u8 const* tail, u64 size);
+
+/************************************************************
+ *              PRIVATE METHODS SIGNATURE END.              *
+ ************************************************************/
+
+/****************************************************
+ *              PUBLIC METHODS START.               *
+ ****************************************************/
+
+u32 xxh32(u32 seed, void const* data, u64 size)
+{
+    Xxh32 state = xxh32_begin(seed);
+
+    xxh32_update(&state, data, size);
+    return xxh32_end(&state);
+}
+
+Xxh32 xxh32_begin(u32 seed)
+{
+    return (Xxh32) {
+        ._acc = {
+            seed + XXH32_PRIME1 + XXH32_PRIME2,
+            seed + XXH32_PRIME2,
+            seed,
+            seed - XXH32_PRIME1,
+        },
+        ._total = 0,
+        ._buf_size = 0,
+        ._seed = seed,
+    };
+}
+
+void xxh32_update(Xxh32* state, void const* data, u64 size)
+{
+    u8 const* src = data;
+    state->_total += size;
+
+    // Fill stripe left from previous update.
+    if (state->_buf_size > 0) {
+        u64 fill = 16 - state->_buf_size;
+        if (size < fill) {
+            memcpy(state->_buf + state->_buf_size, src, size);
+            state->_buf_size += (u32)size;
+            return;
+        }
+
+        memcpy(state->_buf + state->_buf_size, src, fill);
+        _xxh32_stripe(state->_acc, state->_buf);
+        src += fill;
+        size -= fill;
+        state->_buf_size = 0;
+    }
+
+    for (; size >= 16; size -= 16, src += 16) {
+        _xxh32_stripe(state->_acc, src);
+    }
+
+    memcpy(state->_buf, src, size);
+    state->_buf_size = (u32)size;
+}
+
+u32 xxh32_end(Xxh32 const* state)
+{
+    u32 hash;
+
+    if (state->_total >= 16) {
+        hash = _xxh32_rotl(state->_acc[0], 1) + _xxh32_rotl(state->_acc[1], 7)
+             + _xxh32_rotl(state->_acc[2], 12)
+             + _xxh32_rotl(state->_acc[3], 18);
+    }
+    else {
+        hash = state->_seed + XXH32_PRIME5;
+    }
+    hash += (u32)state->_total;
+
+    return _xxh32_finish(hash, state->_buf, state->_buf_size);
+}
+
+/****************************************************
+ *              PUBLIC METHODS END.                 *
+ ****************************************************/
+
+/****************************************************
+ *              PRIVATE METHODS START.              *
+ ****************************************************/
+
+static inline u32 _xxh32_rotl(u32 num, u32 bits)
+{
+    return (num << bits) | (num >> (32 - bits));
+}
+
+static inline u32 _xxh32_load(u8 const* src)
+{
+    return (u32)src[0] | (u32)src[1] << 8 | (u32)src[2] << 16
+         | (u32)src[3] << 24;
+}
+
+static inline u32 _xxh32_round(u32 acc, u32 lane)
+{
+    acc += lane * XXH32_PRIME2;
+    acc = _xxh32_rotl(acc, 13);
+    return acc * XXH32_PRIME1;
+}
+
+static void _xxh32_stripe(u32* acc, u8 const* src)
+{
+    acc[0] = _xxh32_round(acc[0], _xxh32_load(src));
+    acc[1] = _xxh32_round(acc[1], _xxh32_load(src + 4));
+    acc[2] = _xxh32_round(acc[2], _xxh32_load(src + 8));
+    acc[3] = _xxh32_round(acc[3], _xxh32_load(src + 12));
+}
+
+static u32 _xxh32_finish(u32 hash, u8 const* tail, u64 size)
+{
+    for (; size >= 4; size -= 4, tail += 4) {
+        hash += _xxh32_load(tail) * XXH32_PRIME3;
+        hash = _xxh32_rotl(hash, 17) * XXH32_PRIME4;
+    }
+    for (; size > 0; --size, ++tail) {
+        hash += *tail * XXH32_PRIME5;
+        hash = _xxh32_rotl(hash, 11) * XXH32_PRIME1;
+    }
+
+    hash ^= hash >> 15;
+    hash *= XXH32_PRIME2;
+    hash ^= hash >> 13;
+    hash *= XXH32_PRIME3;
+    hash ^= hash >> 16;
+
+    return hash;
+}
+
+/****************************************************
+ *              PRIVATE METHODS END.                *
+ ****************************************************/
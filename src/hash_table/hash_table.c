@@ -0,0 +1,504 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "nclib/hash_table/hash_table.h"
+#include "nclib/panic.h"
+#include "nclib/str/str_view.h"
+
+#if defined(__SSE2__)
+#define HASH_TABLE_SSE2
+#include <emmintrin.h>
+#endif
+
+/********************************************
+ *              DEFINES START.              *
+ ********************************************/
+
+// Full slots store 7 low bits of hash, so special values have high bit set.
+#define HASH_TABLE_EMPTY ((u8)0x80)
+#define HASH_TABLE_DELETED ((u8)0xfe)
+
+#define HASH_TABLE_MIN_CAPACITY 16
+#define HASH_TABLE_SLOT_ALIGN 8
+
+/********************************************
+ *              DEFINES END.                *
+ ********************************************/
+
+/****************************************************************
+ *              PRIVATE METHODS SIGNATURE START.                *
+ ****************************************************************/
+
+static inline u32 _hash_table_match(u8 const* group, u8 h2);
+static inline u32 _hash_table_match_empty(u8 const* group);
+static inline u32 _hash_table_match_empty_or_deleted(u8 const* group);
+
+static u64 _hash_table_find(HashTable const* table, void const* key,
+                            u64 hash);
+static u64 _hash_table_find_free(HashTable const* table, u64 hash);
+static void _hash_table_set_ctrl(HashTable* table, u64 index, u8 ctrl);
+static void _hash_table_resize(HashTable* table, u64 capacity);
+static u64 _hash_table_capacity_for(u64 count);
+
+static inline u8* _hash_table_slot(HashTable const* table, u64 index);
+static inline u64 _hash_table_align(u64 size);
+static inline u64 _hash_table_mix(u64 x);
+static inline u64 _hash_table_load_u64(u8 const* src);
+
+/************************************************************
+ *              PRIVATE METHODS SIGNATURE END.              *
+ ************************************************************/
+
+/****************************************************
+ *              PUBLIC METHODS START.               *
+ ****************************************************/
+
+HashTable hash_table_new(u64 key_size, u64 value_size, HashTableHashFn hash,
+                         HashTableEqFn eq)
+{
+    return hash_table_new_in_arena(key_size, value_size, hash, eq, NULL);
+}
+
+HashTable hash_table_new_in_arena(u64 key_size, u64 value_size,
+                                  HashTableHashFn hash, HashTableEqFn eq,
+                                  Arena* arena)
+{
+    u64 value_offset = _hash_table_align(key_size);
+
+    // Slots are allocated by first insert or reserve.
+    return (HashTable) {
+        ._ctrl = NULL,
+        ._slots = NULL,
+        ._capacity = 0,
+        ._size = 0,
+        ._growth_left = 0,
+        ._key_size = key_size,
+        ._value_size = value_size,
+        ._value_offset = value_offset,
+        ._slot_size = value_offset + _hash_table_align(value_size),
+        ._hash = hash,
+        ._eq = eq,
+        ._arena = arena,
+    };
+}
+
+void hash_table_free(HashTable* table)
+{
+    // Memory of arena table is freed together with arena.
+    if (table->_arena == NULL) {
+        free(table->_ctrl);
+    }
+
+    table->_ctrl = NULL;
+    table->_slots = NULL;
+    table->_capacity = 0;
+    table->_size = 0;
+    table->_growth_left = 0;
+}
+
+void hash_table_reserve(HashTable* table, u64 count)
+{
+    if (count <= table->_size + table->_growth_left) {
+        return;
+    }
+
+    u64 capacity = _hash_table_capacity_for(count);
+    _hash_table_resize(table,
+                       capacity > table->_capacity ? capacity
+                                                   : table->_capacity);
+}
+
+void hash_table_clear(HashTable* table)
+{
+    if (table->_capacity == 0) {
+        return;
+    }
+
+    memset(table->_ctrl, HASH_TABLE_EMPTY,
+           table->_capacity + HASH_TABLE_GROUP_WIDTH);
+    table->_size = 0;
+    table->_growth_left = table->_capacity / 8 * 7;
+}
+
+void* hash_table_get(HashTable const* table, void const* key)
+{
+    if (table->_size == 0) {
+        return NULL;
+    }
+
+    u64 index = _hash_table_find(table, key, table->_hash(key));
+    if (index == table->_capacity) {
+        return NULL;
+    }
+
+    return _hash_table_slot(table, index) + table->_value_offset;
+}
+
+void* hash_table_insert(HashTable* table, void const* key, void const* value)
+{
+    u64 hash = table->_hash(key);
+
+    u64 index = table->_size == 0 ? table->_capacity
+                                  : _hash_table_find(table, key, hash);
+    if (index != table->_capacity) {
+        u8* dst = _hash_table_slot(table, index) + table->_value_offset;
+        memcpy(dst, value, table->_value_size);
+        return dst;
+    }
+
+    if (table->_capacity == 0) {
+        _hash_table_resize(table, HASH_TABLE_MIN_CAPACITY);
+    }
+
+    index = _hash_table_find_free(table, hash);
+
+    // Deleted slot can be reused without growth, otherwise table is rehashed.
+    // When most of used slots are tombstones capacity isn't changed.
+    if (table->_growth_left == 0
+        and table->_ctrl[index] != HASH_TABLE_DELETED) {
+        u64 capacity = table->_size * 16 > table->_capacity * 7
+            ? table->_capacity * 2
+            : table->_capacity;
+        _hash_table_resize(table, capacity);
+        index = _hash_table_find_free(table, hash);
+    }
+
+    if (table->_ctrl[index] == HASH_TABLE_EMPTY) {
+        --table->_growth_left;
+    }
+    _hash_table_set_ctrl(table, index, (u8)(hash & 0x7f));
+    ++table->_size;
+
+    u8* slot = _hash_table_slot(table, index);
+    memcpy(slot, key, table->_key_size);
+    memcpy(slot + table->_value_offset, value, table->_value_size);
+
+    return slot + table->_value_offset;
+}
+
+bool hash_table_remove(HashTable* table, void const* key)
+{
+    if (table->_size == 0) {
+        return false;
+    }
+
+    u64 index = _hash_table_find(table, key, table->_hash(key));
+    if (index == table->_capacity) {
+        return false;
+    }
+
+    // Slot can become empty again if no probe sequence has passed it, it is
+    // true when every group containing slot has empty slot.
+    u64 mask = table->_capacity - 1;
+    u64 before = (index - HASH_TABLE_GROUP_WIDTH) & mask;
+    u32 empty_before = _hash_table_match_empty(table->_ctrl + before);
+    u32 empty_after = _hash_table_match_empty(table->_ctrl + index);
+
+    bool was_never_full = empty_before != 0 and empty_after != 0
+        and (u64)__builtin_ctz(empty_after)
+                + (u64)(__builtin_clz(empty_before) - 16)
+            < HASH_TABLE_GROUP_WIDTH;
+
+    if (was_never_full) {
+        _hash_table_set_ctrl(table, index, HASH_TABLE_EMPTY);
+        ++table->_growth_left;
+    }
+    else {
+        _hash_table_set_ctrl(table, index, HASH_TABLE_DELETED);
+    }
+    --table->_size;
+
+    return true;
+}
+
+bool hash_table_next(HashTable const* table, u64* index, void** key,
+                     void** value)
+{
+    for (; *index < table->_capacity; ++*index) {
+        if (table->_ctrl[*index] & 0x80) {
+            continue;
+        }
+
+        u8* slot = _hash_table_slot(table, *index);
+        *key = slot;
+        *value = slot + table->_value_offset;
+        ++*index;
+        return true;
+    }
+
+    return false;
+}
+
+u64 hash_table_hash_bytes(void const* data, u64 size)
+{
+    u8 const* bytes = data;
+    u64 hash = size * 0x9e3779b97f4a7c15;
+
+    for (; size >= 8; size -= 8, bytes += 8) {
+        hash = _hash_table_mix(hash ^ _hash_table_load_u64(bytes));
+    }
+
+    u64 tail = 0;
+    for (u64 i = 0; i < size; ++i) {
+        tail |= (u64)bytes[i] << (8 * i);
+    }
+
+    return _hash_table_mix(hash ^ tail);
+}
+
+u64 hash_table_hash_u32(void const* key)
+{
+    u32 num;
+    memcpy(&num, key, sizeof num);
+    return _hash_table_mix(num);
+}
+
+u64 hash_table_hash_u64(void const* key)
+{
+    u64 num;
+    memcpy(&num, key, sizeof num);
+    return _hash_table_mix(num);
+}
+
+u64 hash_table_hash_str_view(void const* key)
+{
+    StrView const* view = key;
+    return hash_table_hash_bytes(view->ptr, view->len);
+}
+
+bool hash_table_eq_u32(void const* left, void const* right)
+{
+    return memcmp(left, right, sizeof(u32)) == 0;
+}
+
+bool hash_table_eq_u64(void const* left, void const* right)
+{
+    return memcmp(left, right, sizeof(u64)) == 0;
+}
+
+bool hash_table_eq_str_view(void const* left, void const* right)
+{
+    return str_view_eq(*(StrView const*)left, *(StrView const*)right);
+}
+
+/****************************************************
+ *              PUBLIC METHODS END.                 *
+ ****************************************************/
+
+/****************************************************
+ *              PRIVATE METHODS START.              *
+ ****************************************************/
+
+#ifdef HASH_TABLE_SSE2
+
+static inline u32 _hash_table_match(u8 const* group, u8 h2)
+{
+    __m128i ctrl = _mm_loadu_si128((__m128i const*)group);
+    __m128i pattern = _mm_set1_epi8((char)h2);
+    return (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, pattern));
+}
+
+static inline u32 _hash_table_match_empty(u8 const* group)
+{
+    return _hash_table_match(group, HASH_TABLE_EMPTY);
+}
+
+static inline u32 _hash_table_match_empty_or_deleted(u8 const* group)
+{
+    return (u32)_mm_movemask_epi8(_mm_loadu_si128((__m128i const*)group));
+}
+
+#else
+
+#define HASH_TABLE_LSBS 0x0101010101010101
+#define HASH_TABLE_MSBS 0x8080808080808080
+
+// Gather high bits of bytes into 8 bit mask.
+static inline u32 _hash_table_swar_mask(u64 bits)
+{
+    return (u32)(((bits >> 7) * 0x0102040810204080) >> 56);
+}
+
+static inline u32 _hash_table_match(u8 const* group, u8 h2)
+{
+    u32 mask = 0;
+
+    // Borrow can mark byte after match, such byte is full slot with
+    // h2 ^ 1, so false positive is rejected by key comparison.
+    for (u64 half = 0; half < 2; ++half) {
+        u64 ctrl = _hash_table_load_u64(group + half * 8)
+            ^ (HASH_TABLE_LSBS * h2);
+        u64 bits = (ctrl - HASH_TABLE_LSBS) & ~ctrl & HASH_TABLE_MSBS;
+        mask |= _hash_table_swar_mask(bits) << (half * 8);
+    }
+
+    return mask;
+}
+
+static inline u32 _hash_table_match_empty(u8 const* group)
+{
+    u32 mask = 0;
+
+    // Empty is the only special value without second bit.
+    for (u64 half = 0; half < 2; ++half) {
+        u64 ctrl = _hash_table_load_u64(group + half * 8);
+        u64 bits = ctrl & ~(ctrl << 6) & HASH_TABLE_MSBS;
+        mask |= _hash_table_swar_mask(bits) << (half * 8);
+    }
+
+    return mask;
+}
+
+static inline u32 _hash_table_match_empty_or_deleted(u8 const* group)
+{
+    u32 mask = 0;
+
+    for (u64 half = 0; half < 2; ++half) {
+        u64 ctrl = _hash_table_load_u64(group + half * 8);
+        mask |= _hash_table_swar_mask(ctrl & HASH_TABLE_MSBS) << (half * 8);
+    }
+
+    return mask;
+}
+
+#endif // endif HASH_TABLE_SSE2
+
+static u64 _hash_table_find(HashTable const* table, void const* key,
+                            u64 hash)
+{
+    u64 mask = table->_capacity - 1;
+    u64 pos = (hash >> 7) & mask;
+    u8 h2 = (u8)(hash & 0x7f);
+
+    // Triangular probing visits every group when capacity is power of 2.
+    for (u64 step = HASH_TABLE_GROUP_WIDTH;; step += HASH_TABLE_GROUP_WIDTH) {
+        u8 const* group = table->_ctrl + pos;
+
+        for (u32 matches = _hash_table_match(group, h2); matches != 0;
+             matches &= matches - 1) {
+            u64 index = (pos + (u64)__builtin_ctz(matches)) & mask;
+            if (table->_eq(key, _hash_table_slot(table, index))) {
+                return index;
+            }
+        }
+
+        if (_hash_table_match_empty(group) != 0) {
+            return table->_capacity;
+        }
+        pos = (pos + step) & mask;
+    }
+}
+
+static u64 _hash_table_find_free(HashTable const* table, u64 hash)
+{
+    u64 mask = table->_capacity - 1;
+    u64 pos = (hash >> 7) & mask;
+
+    for (u64 step = HASH_TABLE_GROUP_WIDTH;; step += HASH_TABLE_GROUP_WIDTH) {
+        u32 free_slots
+            = _hash_table_match_empty_or_deleted(table->_ctrl + pos);
+
+        if (free_slots != 0) {
+            return (pos + (u64)__builtin_ctz(free_slots)) & mask;
+        }
+        pos = (pos + step) & mask;
+    }
+}
+
+static void _hash_table_set_ctrl(HashTable* table, u64 index, u8 ctrl)
+{
+    table->_ctrl[index] = ctrl;
+
+    // First group is cloned after last slot, so groups can be loaded
+    // without wrapping.
+    if (index < HASH_TABLE_GROUP_WIDTH) {
+        table->_ctrl[table->_capacity + index] = ctrl;
+    }
+}
+
+static void _hash_table_resize(HashTable* table, u64 capacity)
+{
+    u64 ctrl_size = _hash_table_align(capacity + HASH_TABLE_GROUP_WIDTH);
+    u64 size = ctrl_size + capacity * table->_slot_size;
+
+    u8* memory = table->_arena != NULL
+        ? arena_alloc_aligned(table->_arena, size, HASH_TABLE_SLOT_ALIGN)
+        : malloc(size);
+    if (memory == NULL) {
+        panic("Error: can't allocate %lu bytes for hash table.\n", size);
+    }
+
+    HashTable old = *table;
+
+    table->_ctrl = memory;
+    table->_slots = memory + ctrl_size;
+    table->_capacity = capacity;
+    memset(table->_ctrl, HASH_TABLE_EMPTY, capacity + HASH_TABLE_GROUP_WIDTH);
+
+    // Keys are unique, so they are moved without comparison.
+    for (u64 i = 0; i < old._capacity; ++i) {
+        if (old._ctrl[i] & 0x80) {
+            continue;
+        }
+
+        u8 const* slot = _hash_table_slot(&old, i);
+        u64 hash = table->_hash(slot);
+        u64 index = _hash_table_find_free(table, hash);
+
+        _hash_table_set_ctrl(table, index, old._ctrl[i]);
+        memcpy(_hash_table_slot(table, index), slot, table->_slot_size);
+    }
+
+    table->_growth_left = capacity / 8 * 7 - table->_size;
+
+    if (old._arena == NULL) {
+        free(old._ctrl);
+    }
+}
+
+static u64 _hash_table_capacity_for(u64 count)
+{
+    u64 capacity = HASH_TABLE_MIN_CAPACITY;
+
+    while (capacity / 8 * 7 < count) {
+        capacity *= 2;
+    }
+
+    return capacity;
+}
+
+static inline u8* _hash_table_slot(HashTable const* table, u64 index)
+{
+    return table->_slots + index * table->_slot_size;
+}
+
+static inline u64 _hash_table_align(u64 size)
+{
+    return (size + HASH_TABLE_SLOT_ALIGN - 1)
+        & ~(u64)(HASH_TABLE_SLOT_ALIGN - 1);
+}
+
+static inline u64 _hash_table_mix(u64 x)
+{
+    x ^= x >> 32;
+    x *= 0xd6e8feb86659fd93;
+    x ^= x >> 32;
+    x *= 0xd6e8feb86659fd93;
+    x ^= x >> 32;
+    return x;
+}
+
+// Little endian load, so byte i of group is byte i of number.
+static inline u64 _hash_table_load_u64(u8 const* src)
+{
+    u64 num;
+    memcpy(&num, src, sizeof num);
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    num = __builtin_bswap64(num);
+#endif
+    return num;
+}
+
+/****************************************************
+ *              PRIVATE METHODS END.                *
+ ****************************************************/
@@ -0,0 +1,351 @@
+// syscall is hidden by strict c2x mode.
+#define _DEFAULT_SOURCE
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "nclib/panic.h"
+#include "nclib/queue/mpmc_queue.h"
+
+#ifdef __linux__
+#define MPMC_QUEUE_FUTEX
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/********************************************
+ *              DEFINES START.              *
+ ********************************************/
+
+// Cell is sequence number followed by item.
+#define MPMC_QUEUE_SEQ_SIZE 8
+
+// Tries of blocking call before it goes to sleep.
+#define MPMC_QUEUE_SPIN_COUNT 64
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MPMC_QUEUE_SPIN_PAUSE() __builtin_ia32_pause()
+#else
+#define MPMC_QUEUE_SPIN_PAUSE()
+#endif
+
+/********************************************
+ *              DEFINES END.                *
+ ********************************************/
+
+/****************************************************************
+ *              PRIVATE METHODS SIGNATURE START.                *
+ ****************************************************************/
+
+static MpmcQueue _mpmc_queue_new(u64 capacity, u64 item_size, bool blocking);
+static inline _Atomic(u64)* _mpmc_queue_seq(MpmcQueue const* queue, u64 pos);
+static inline u8* _mpmc_queue_item(MpmcQueue const* queue, u64 pos);
+static u64 _mpmc_queue_claim(MpmcQueue* queue, _Atomic(u64)* counter,
+                             u64 ready, u64 count, u64* pos);
+
+static void _mpmc_queue_check_blocking(MpmcQueue const* queue);
+static void _mpmc_queue_wake(MpmcQueue* queue, _Atomic(u32)* waiters,
+                             _Atomic(u32)* event, u64 count);
+static void _mpmc_queue_sleep(_Atomic(u32)* event, u32 seen);
+
+/************************************************************
+ *              PRIVATE METHODS SIGNATURE END.              *
+ ************************************************************/
+
+/****************************************************
+ *              PUBLIC METHODS START.               *
+ ****************************************************/
+
+MpmcQueue mpmc_queue_new(u64 capacity, u64 item_size)
+{
+    return _mpmc_queue_new(capacity, item_size, false);
+}
+
+MpmcQueue mpmc_queue_new_blocking(u64 capacity, u64 item_size)
+{
+    return _mpmc_queue_new(capacity, item_size, true);
+}
+
+void mpmc_queue_free(MpmcQueue* queue)
+{
+    free(queue->_cells);
+    queue->_cells = NULL;
+    queue->_mask = 0;
+}
+
+bool mpmc_queue_try_push(MpmcQueue* queue, void const* item)
+{
+    return mpmc_queue_try_push_batch(queue, item, 1) == 1;
+}
+
+bool mpmc_queue_try_pop(MpmcQueue* queue, void* item)
+{
+    return mpmc_queue_try_pop_batch(queue, item, 1) == 1;
+}
+
+u64 mpmc_queue_try_push_batch(MpmcQueue* queue, void const* items,
+                              u64 count)
+{
+    u64 pos;
+    u64 claimed = _mpmc_queue_claim(queue, &queue->_push_pos, 0, count, &pos);
+
+    // Release publishes item together with sequence of full cell.
+    for (u64 i = 0; i < claimed; ++i) {
+        memcpy(_mpmc_queue_item(queue, pos + i),
+               (u8 const*)items + i * queue->_item_size, queue->_item_size);
+        atomic_store_explicit(_mpmc_queue_seq(queue, pos + i), pos + i + 1,
+                              memory_order_release);
+    }
+
+    if (claimed != 0) {
+        _mpmc_queue_wake(queue, &queue->_pop_waiters, &queue->_push_event,
+                         claimed);
+    }
+    return claimed;
+}
+
+u64 mpmc_queue_try_pop_batch(MpmcQueue* queue, void* items, u64 count)
+{
+    u64 pos;
+    u64 claimed = _mpmc_queue_claim(queue, &queue->_pop_pos, 1, count, &pos);
+
+    // Cell becomes free for push of next lap.
+    for (u64 i = 0; i < claimed; ++i) {
+        memcpy((u8*)items + i * queue->_item_size,
+               _mpmc_queue_item(queue, pos + i), queue->_item_size);
+        atomic_store_explicit(_mpmc_queue_seq(queue, pos + i),
+                              pos + i + queue->_mask + 1,
+                              memory_order_release);
+    }
+
+    if (claimed != 0) {
+        _mpmc_queue_wake(queue, &queue->_push_waiters, &queue->_pop_event,
+                         claimed);
+    }
+    return claimed;
+}
+
+void mpmc_queue_push(MpmcQueue* queue, void const* item)
+{
+    mpmc_queue_push_batch(queue, item, 1);
+}
+
+void mpmc_queue_pop(MpmcQueue* queue, void* item)
+{
+    mpmc_queue_pop_batch(queue, item, 1);
+}
+
+void mpmc_queue_push_batch(MpmcQueue* queue, void const* items, u64 count)
+{
+    _mpmc_queue_check_blocking(queue);
+
+    u8 const* src = items;
+    u64 spins = 0;
+
+    while (count > 0) {
+        u64 pushed = mpmc_queue_try_push_batch(queue, src, count);
+        src += pushed * queue->_item_size;
+        count -= pushed;
+
+        if (pushed != 0 or count == 0) {
+            spins = 0;
+            continue;
+        }
+        if (++spins < MPMC_QUEUE_SPIN_COUNT) {
+            MPMC_QUEUE_SPIN_PAUSE();
+            continue;
+        }
+
+        // Pop after waiter registration changes event, so wake isn't lost.
+        atomic_fetch_add(&queue->_push_waiters, 1);
+        atomic_thread_fence(memory_order_seq_cst);
+        u32 seen = atomic_load(&queue->_pop_event);
+        pushed = mpmc_queue_try_push_batch(queue, src, count);
+        if (pushed == 0) {
+            _mpmc_queue_sleep(&queue->_pop_event, seen);
+        }
+        atomic_fetch_sub(&queue->_push_waiters, 1);
+
+        src += pushed * queue->_item_size;
+        count -= pushed;
+    }
+}
+
+u64 mpmc_queue_pop_batch(MpmcQueue* queue, void* items, u64 count)
+{
+    _mpmc_queue_check_blocking(queue);
+
+    for (u64 spins = 0;; ++spins) {
+        u64 popped = mpmc_queue_try_pop_batch(queue, items, count);
+        if (popped != 0 or count == 0) {
+            return popped;
+        }
+        if (spins < MPMC_QUEUE_SPIN_COUNT) {
+            MPMC_QUEUE_SPIN_PAUSE();
+            continue;
+        }
+
+        atomic_fetch_add(&queue->_pop_waiters, 1);
+        atomic_thread_fence(memory_order_seq_cst);
+        u32 seen = atomic_load(&queue->_push_event);
+        popped = mpmc_queue_try_pop_batch(queue, items, count);
+        if (popped == 0) {
+            _mpmc_queue_sleep(&queue->_push_event, seen);
+        }
+        atomic_fetch_sub(&queue->_pop_waiters, 1);
+
+        if (popped != 0) {
+            return popped;
+        }
+    }
+}
+
+/****************************************************
+ *              PUBLIC METHODS END.                 *
+ ****************************************************/
+
+/****************************************************
+ *              PRIVATE METHODS START.              *
+ ****************************************************/
+
+static MpmcQueue _mpmc_queue_new(u64 capacity, u64 item_size, bool blocking)
+{
+    if (capacity < 2 or (capacity & (capacity - 1)) != 0) {
+        panic("Error: mpmc queue capacity %lu is not power of two.\n",
+              capacity);
+    }
+
+    u64 cell_size = (MPMC_QUEUE_SEQ_SIZE + item_size + 7) & ~(u64)7;
+    u8* cells = malloc(capacity * cell_size);
+    if (cells == NULL) {
+        panic("Error: can't allocate %lu bytes for mpmc queue.\n",
+              capacity * cell_size);
+    }
+
+    MpmcQueue queue = {
+        ._push_pos = 0,
+        ._pop_pos = 0,
+        ._push_event = 0,
+        ._pop_event = 0,
+        ._push_waiters = 0,
+        ._pop_waiters = 0,
+        ._cells = cells,
+        ._mask = capacity - 1,
+        ._item_size = item_size,
+        ._cell_size = cell_size,
+        ._blocking = blocking,
+    };
+
+    // Cell of position i is free for push of position i.
+    for (u64 i = 0; i < capacity; ++i) {
+        atomic_init(_mpmc_queue_seq(&queue, i), i);
+    }
+
+    return queue;
+}
+
+static inline _Atomic(u64)* _mpmc_queue_seq(MpmcQueue const* queue, u64 pos)
+{
+    return (_Atomic(u64)*)(void*)(queue->_cells
+                                  + (pos & queue->_mask) * queue->_cell_size);
+}
+
+static inline u8* _mpmc_queue_item(MpmcQueue const* queue, u64 pos)
+{
+    return queue->_cells + (pos & queue->_mask) * queue->_cell_size
+         + MPMC_QUEUE_SEQ_SIZE;
+}
+
+/* Claim up to `count` consecutive positions of counter whose cells have
+ * sequence `pos + ready`, returns count of claimed positions. Cells stay
+ * ready until claimed position is committed, because only owner of
+ * position can change sequence of its cell. */
+static u64 _mpmc_queue_claim(MpmcQueue* queue, _Atomic(u64)* counter,
+                             u64 ready, u64 count, u64* pos)
+{
+    u64 first = atomic_load_explicit(counter, memory_order_relaxed);
+
+    while (count > 0) {
+        u64 seq = atomic_load_explicit(_mpmc_queue_seq(queue, first),
+                                       memory_order_acquire);
+        i64 diff = (i64)(seq - (first + ready));
+
+        // Cell is from previous lap: queue is full (or empty).
+        if (diff < 0) {
+            return 0;
+        }
+        // Other thread already claimed position.
+        if (diff > 0) {
+            first = atomic_load_explicit(counter, memory_order_relaxed);
+            continue;
+        }
+
+        u64 claimed = 1;
+        while (claimed < count
+               and atomic_load_explicit(
+                       _mpmc_queue_seq(queue, first + claimed),
+                       memory_order_acquire)
+                       == first + claimed + ready) {
+            ++claimed;
+        }
+
+        if (atomic_compare_exchange_weak_explicit(
+                counter, &first, first + claimed, memory_order_relaxed,
+                memory_order_relaxed)) {
+            *pos = first;
+            return claimed;
+        }
+    }
+
+    return 0;
+}
+
+static void _mpmc_queue_check_blocking(MpmcQueue const* queue)
+{
+    if (not queue->_blocking) {
+        panic("Error: blocking call on mpmc queue created without "
+              "mpmc_queue_new_blocking.\n");
+    }
+}
+
+/* Wake waiters of event after push (pop). Fence orders committed cells
+ * before read of waiters, waiter has the same fence between registration
+ * and second check of cells, so one of them sees the other. */
+static void _mpmc_queue_wake(MpmcQueue* queue, _Atomic(u32)* waiters,
+                             _Atomic(u32)* event, u64 count)
+{
+    if (not queue->_blocking) {
+        return;
+    }
+
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(waiters, memory_order_relaxed) == 0) {
+        return;
+    }
+
+    atomic_fetch_add(event, 1);
+#ifdef MPMC_QUEUE_FUTEX
+    syscall(SYS_futex, event, FUTEX_WAKE_PRIVATE,
+            count < INT_MAX ? (int)count : INT_MAX, NULL, NULL, 0);
+#else
+    (void)count;
+#endif
+}
+
+static void _mpmc_queue_sleep(_Atomic(u32)* event, u32 seen)
+{
+#ifdef MPMC_QUEUE_FUTEX
+    // Returns at once if event was already changed.
+    syscall(SYS_futex, event, FUTEX_WAIT_PRIVATE, seen, NULL, NULL, 0);
+#else
+    while (atomic_load(event) == seen) {
+        MPMC_QUEUE_SPIN_PAUSE();
+    }
+#endif
+}
+
+/****************************************************
+ *              PRIVATE METHODS END.                *
+ ****************************************************/
@@ -0,0 +1,125 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "nclib/panic.h"
+#include "nclib/str/str.h"
+
+/****************************************************************
+ *              PRIVATE METHODS SIGNATURE START.                *
+ ****************************************************************/
+
+static void _str_grow(Str* str, u64 capacity);
+
+/************************************************************
+ *              PRIVATE METHODS SIGNATURE END.              *
+ ************************************************************/
+
+/****************************************************
+ *              PUBLIC METHODS START.               *
+ ****************************************************/
+
+Str str_new(void)
+{
+    return (Str) {
+        ._len = 0,
+        ._capacity = 0,
+        ._inline = { 0 },
+    };
+}
+
+Str str_with_capacity(u64 capacity)
+{
+    Str str = str_new();
+    str_reserve(&str, capacity);
+    return str;
+}
+
+Str str_from_cstr(char const* cstr)
+{
+    return str_from_view(str_view_from_cstr(cstr));
+}
+
+Str str_from_view(StrView view)
+{
+    Str str = str_with_capacity(view.len);
+    str_append(&str, view);
+    return str;
+}
+
+void str_free(Str* str)
+{
+    if (not str_is_inline(str)) {
+        free(str->_heap);
+    }
+    *str = str_new();
+}
+
+void str_reserve(Str* str, u64 capacity)
+{
+    if (capacity <= str_capacity(str)) {
+        return;
+    }
+
+    u64 doubled = str_capacity(str) * 2;
+    _str_grow(str, capacity > doubled ? capacity : doubled);
+}
+
+void str_append(Str* str, StrView view)
+{
+    // View may point into str itself, grow moves its chars.
+    char const* old_data = str_data(str);
+    uintptr_t start = (uintptr_t)old_data;
+    uintptr_t ptr = (uintptr_t)view.ptr;
+    bool is_self = ptr >= start and ptr <= start + str->_len;
+
+    str_reserve(str, str->_len + view.len);
+
+    char* data = str_data(str);
+    if (is_self) {
+        view.ptr = data + (ptr - start);
+    }
+    memcpy(data + str->_len, view.ptr, view.len);
+    str->_len += view.len;
+    data[str->_len] = '\0';
+}
+
+void str_push(Str* str, char c)
+{
+    str_append(str, str_view_new(&c, 1));
+}
+
+void str_clear(Str* str)
+{
+    str->_len = 0;
+    str_data(str)[0] = '\0';
+}
+
+/****************************************************
+ *              PUBLIC METHODS END.                 *
+ ****************************************************/
+
+/****************************************************
+ *              PRIVATE METHODS START.              *
+ ****************************************************/
+
+static void _str_grow(Str* str, u64 capacity)
+{
+    // Extra byte for null terminator.
+    char* heap = str_is_inline(str) ? malloc(capacity + 1)
+                                    : realloc(str->_heap, capacity + 1);
+    if (heap == NULL) {
+        panic("Error: can't allocate %lu bytes for str.\n", capacity + 1);
+    }
+
+    // Inline chars share memory with heap pointer, so copy them before.
+    if (str_is_inline(str)) {
+        memcpy(heap, str->_inline, str->_len + 1);
+    }
+
+    str->_heap = heap;
+    str->_capacity = capacity;
+}
+
+/****************************************************
+ *              PRIVATE METHODS END.                *
+ ****************************************************/
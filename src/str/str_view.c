@@ -0,0 +1,227 @@
+#include <string.h>
+
+#include "nclib/str/str_view.h"
+
+#if defined(__SSE2__)
+#define STR_SSE2
+#include <emmintrin.h>
+#endif
+
+/****************************************************************
+ *              PRIVATE METHODS SIGNATURE START.                *
+ ****************************************************************/
+
+static u64 _str_view_find_char_scalar(char const* ptr, u64 len, char c);
+static u64 _str_view_find_scalar(StrView haystack, StrView needle);
+
+#ifdef STR_SSE2
+static u64 _str_view_find_char_sse2(char const* ptr, u64 len, char c);
+static u64 _str_view_find_sse2(StrView haystack, StrView needle);
+static bool _str_view_eq_sse2(char const* left, char const* right, u64 len);
+#endif
+
+/************************************************************
+ *              PRIVATE METHODS SIGNATURE END.              *
+ ************************************************************/
+
+/****************************************************
+ *              PUBLIC METHODS START.               *
+ ****************************************************/
+
+StrView str_view_new(char const* ptr, u64 len)
+{
+    return (StrView) { .ptr = ptr, .len = len };
+}
+
+StrView str_view_from_cstr(char const* cstr)
+{
+    return str_view_new(cstr, strlen(cstr));
+}
+
+bool str_view_eq(StrView left, StrView right)
+{
+    if (left.len != right.len) {
+        return false;
+    }
+
+#ifdef STR_SSE2
+    return _str_view_eq_sse2(left.ptr, right.ptr, left.len);
+#else
+    return left.len == 0 or memcmp(left.ptr, right.ptr, left.len) == 0;
+#endif
+}
+
+bool str_view_starts_with(StrView view, StrView prefix)
+{
+    return prefix.len <= view.len
+        and str_view_eq(str_view_slice(view, 0, prefix.len), prefix);
+}
+
+bool str_view_ends_with(StrView view, StrView suffix)
+{
+    return suffix.len <= view.len
+        and str_view_eq(
+            str_view_slice(view, view.len - suffix.len, suffix.len), suffix);
+}
+
+u64 str_view_find_char(StrView view, char c)
+{
+#ifdef STR_SSE2
+    return _str_view_find_char_sse2(view.ptr, view.len, c);
+#else
+    return _str_view_find_char_scalar(view.ptr, view.len, c);
+#endif
+}
+
+u64 str_view_find(StrView haystack, StrView needle)
+{
+    if (needle.len == 0) {
+        return 0;
+    }
+    if (needle.len > haystack.len) {
+        return STR_NOT_FOUND;
+    }
+    if (needle.len == 1) {
+        return str_view_find_char(haystack, needle.ptr[0]);
+    }
+
+#ifdef STR_SSE2
+    return _str_view_find_sse2(haystack, needle);
+#else
+    return _str_view_find_scalar(haystack, needle);
+#endif
+}
+
+StrView str_view_slice(StrView view, u64 start, u64 len)
+{
+    // Slice is clamped by view bounds.
+    if (start > view.len) {
+        start = view.len;
+    }
+    if (len > view.len - start) {
+        len = view.len - start;
+    }
+
+    return str_view_new(view.ptr + start, len);
+}
+
+bool str_view_split(StrView* rest, char delim, StrView* token)
+{
+    if (rest->ptr == NULL) {
+        return false;
+    }
+
+    u64 index = str_view_find_char(*rest, delim);
+
+    // Last token, next call returns false.
+    if (index == STR_NOT_FOUND) {
+        *token = *rest;
+        *rest = str_view_new(NULL, 0);
+        return true;
+    }
+
+    *token = str_view_slice(*rest, 0, index);
+    *rest = str_view_slice(*rest, index + 1, rest->len);
+    return true;
+}
+
+/****************************************************
+ *              PUBLIC METHODS END.                 *
+ ****************************************************/
+
+/****************************************************
+ *              PRIVATE METHODS START.              *
+ ****************************************************/
+
+static u64 _str_view_find_char_scalar(char const* ptr, u64 len, char c)
+{
+    for (u64 i = 0; i < len; ++i) {
+        if (ptr[i] == c) {
+            return i;
+        }
+    }
+    return STR_NOT_FOUND;
+}
+
+static u64 _str_view_find_scalar(StrView haystack, StrView needle)
+{
+    for (u64 i = 0; i + needle.len <= haystack.len; ++i) {
+        if (memcmp(haystack.ptr + i, needle.ptr, needle.len) == 0) {
+            return i;
+        }
+    }
+    return STR_NOT_FOUND;
+}
+
+#ifdef STR_SSE2
+
+static u64 _str_view_find_char_sse2(char const* ptr, u64 len, char c)
+{
+    __m128i needle = _mm_set1_epi8(c);
+    u64 i = 0;
+
+    for (; i + 16 <= len; i += 16) {
+        __m128i chunk = _mm_loadu_si128((__m128i const*)(ptr + i));
+        u32 mask = (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle));
+
+        if (mask != 0) {
+            return i + (u64)__builtin_ctz(mask);
+        }
+    }
+
+    u64 index = _str_view_find_char_scalar(ptr + i, len - i, c);
+    return index == STR_NOT_FOUND ? STR_NOT_FOUND : i + index;
+}
+
+static u64 _str_view_find_sse2(StrView haystack, StrView needle)
+{
+    // Compare first and last chars of needle with 16 positions at once, only
+    // positions where both match are checked by memcmp.
+    __m128i first = _mm_set1_epi8(needle.ptr[0]);
+    __m128i last = _mm_set1_epi8(needle.ptr[needle.len - 1]);
+    u64 i = 0;
+
+    for (; i + needle.len - 1 + 16 <= haystack.len; i += 16) {
+        __m128i block_first
+            = _mm_loadu_si128((__m128i const*)(haystack.ptr + i));
+        __m128i block_last = _mm_loadu_si128(
+            (__m128i const*)(haystack.ptr + i + needle.len - 1));
+        u32 mask = (u32)_mm_movemask_epi8(_mm_and_si128(
+            _mm_cmpeq_epi8(first, block_first), _mm_cmpeq_epi8(last, block_last)));
+
+        while (mask != 0) {
+            u64 pos = i + (u64)__builtin_ctz(mask);
+            if (memcmp(haystack.ptr + pos + 1, needle.ptr + 1, needle.len - 2)
+                == 0) {
+                return pos;
+            }
+            mask &= mask - 1;
+        }
+    }
+
+    StrView tail = str_view_slice(haystack, i, haystack.len);
+    u64 index = _str_view_find_scalar(tail, needle);
+    return index == STR_NOT_FOUND ? STR_NOT_FOUND : i + index;
+}
+
+static bool _str_view_eq_sse2(char const* left, char const* right, u64 len)
+{
+    u64 i = 0;
+
+    for (; i + 16 <= len; i += 16) {
+        __m128i l = _mm_loadu_si128((__m128i const*)(left + i));
+        __m128i r = _mm_loadu_si128((__m128i const*)(right + i));
+
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(l, r)) != 0xffff) {
+            return false;
+        }
+    }
+
+    return i == len or memcmp(left + i, right + i, len - i) == 0;
+}
+
+#endif // endif STR_SSE2
+
+/****************************************************
+ *              PRIVATE METHODS END.                *
+ ****************************************************/
@@ -0,0 +1,76 @@
+#include "nclib/streams/bit_stream.h"
+
+/****************************************************
+ *              PUBLIC METHODS START.               *
+ ****************************************************/
+
+BitStream bit_stream_new(u8 const* buf, u64 size, BitStreamOrder order)
+{
+    return (BitStream) {
+        ._buf = buf,
+        ._size = size,
+        ._offset = 0,
+        ._bit_offset = 0,
+        ._bits = 0,
+        ._count = 0,
+        ._order = order,
+    };
+}
+
+BitStream bit_stream_new_msb(u8 const* buf, u64 size)
+{
+    return bit_stream_new(buf, size, BIT_STREAM_MSB_FIRST);
+}
+
+BitStream bit_stream_new_lsb(u8 const* buf, u64 size)
+{
+    return bit_stream_new(buf, size, BIT_STREAM_LSB_FIRST);
+}
+
+void bit_stream_skip_bits(BitStream* stream, u64 count)
+{
+    if (count <= stream->_count) {
+        _bit_stream_consume(stream, (u32)count);
+        return;
+    }
+
+    BIT_STREAM_CHECK_BOUND(stream, count);
+
+    // Drop bit buffer and start loading from byte with new position.
+    u64 position = stream->_bit_offset + count;
+    stream->_offset = position / 8;
+    stream->_bit_offset = position - position % 8;
+    stream->_bits = 0;
+    stream->_count = 0;
+
+    _bit_stream_refill(stream);
+    _bit_stream_consume(stream, (u32)(position % 8));
+}
+
+void bit_stream_align(BitStream* stream)
+{
+    bit_stream_skip_bits(stream, (8 - stream->_bit_offset % 8) % 8);
+}
+
+void _bit_stream_refill_slow(BitStream* stream)
+{
+    // Near end of buffer bytes are loaded one by one, missing bytes are zeros.
+    while (stream->_count < 56) {
+        u64 byte = 0;
+        if (stream->_offset < stream->_size) {
+            byte = stream->_buf[stream->_offset++];
+        }
+
+        if (stream->_order == BIT_STREAM_LSB_FIRST) {
+            stream->_bits |= byte << stream->_count;
+        }
+        else {
+            stream->_bits |= byte << (56 - stream->_count);
+        }
+        stream->_count += 8;
+    }
+}
+
+/****************************************************
+ *              PUBLIC METHODS END.                 *
+ ****************************************************/
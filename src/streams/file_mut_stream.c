@@ -0,0 +1,277 @@
+// ssize_t and struct iovec are hidden by strict c2x mode.
+#define _DEFAULT_SOURCE
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "nclib/panic.h"
+#include "nclib/streams/_streams_bswap.h"
+#include "nclib/streams/file_mut_stream.h"
+
+/********************************************
+ *              DEFINES START.              *
+ ********************************************/
+
+#define GEN_WRITE_METHOD_FOR(_type_)                                          \
+    void file_mut_stream_write_##_type_(FileMutStream* stream, _type_ buf)    \
+    {                                                                         \
+        stream->_write_bytes_impl(stream, (u8*)(&buf), sizeof buf);           \
+    }
+
+#define GEN_WRITE_ARRAY_METHOD_FOR(_type_)                                    \
+    void file_mut_stream_write_##_type_##_array(                              \
+        FileMutStream* stream, _type_ const* src, u64 count)                  \
+    {                                                                         \
+        _file_mut_stream_write_array(stream, (u8 const*)src, count,           \
+                                     sizeof(_type_));                         \
+    }
+
+/********************************************
+ *              DEFINES END.                *
+ ********************************************/
+
+/****************************************************************
+ *              PRIVATE METHODS SIGNATURE START.                *
+ ****************************************************************/
+
+static inline FileMutStreamWriteBytesFn
+_file_mut_stream_find_write_bytes_impl(StreamEndian endian);
+static void _file_mut_stream_write_straight_bytes(FileMutStream* stream,
+                                                  u8 const* src, u64 size);
+static void _file_mut_stream_write_reverse_bytes(FileMutStream* stream,
+                                                 u8 const* src, u64 size);
+static void _file_mut_stream_write_slow(FileMutStream* stream, u8 const* src,
+                                        u64 size);
+static void _file_mut_stream_write_array(FileMutStream* stream, u8 const* src,
+                                         u64 count, u64 item_size);
+
+static void _file_mut_stream_writev(FileMutStream* stream, struct iovec* iov,
+                                    int iov_count);
+
+/************************************************************
+ *              PRIVATE METHODS SIGNATURE END.              *
+ ************************************************************/
+
+/****************************************************
+ *              PUBLIC METHODS START.               *
+ ****************************************************/
+
+FileMutStream file_mut_stream_new(int fd, u64 buffer_size,
+                                  StreamEndian endian)
+{
+    if (buffer_size == 0) {
+        buffer_size = FILE_MUT_STREAM_DEFAULT_BUFFER_SIZE;
+    }
+
+    u8* buf = malloc(buffer_size);
+    if (buf == NULL) {
+        panic("Error: can't allocate %lu bytes for file stream buffer.\n",
+              buffer_size);
+    }
+
+    return (FileMutStream) {
+        ._fd = fd,
+        ._buf = buf,
+        ._capacity = buffer_size,
+        ._size = 0,
+        ._flushed = 0,
+        ._endian = endian,
+        ._write_bytes_impl = _file_mut_stream_find_write_bytes_impl(endian),
+    };
+}
+
+FileMutStream file_mut_stream_new_be(int fd, u64 buffer_size)
+{
+    return file_mut_stream_new(fd, buffer_size, STREAM_BIG_ENDIAN);
+}
+
+FileMutStream file_mut_stream_new_le(int fd, u64 buffer_size)
+{
+    return file_mut_stream_new(fd, buffer_size, STREAM_LITTLE_ENDIAN);
+}
+
+void file_mut_stream_free(FileMutStream* stream)
+{
+    file_mut_stream_flush(stream);
+
+    free(stream->_buf);
+    stream->_buf = NULL;
+    stream->_capacity = 0;
+}
+
+void file_mut_stream_write_bytes(FileMutStream* stream, u8 const* bytes,
+                                 u64 size)
+{
+    _file_mut_stream_write_straight_bytes(stream, bytes, size);
+}
+
+void file_mut_stream_flush(FileMutStream* stream)
+{
+    if (stream->_size == 0) {
+        return;
+    }
+
+    struct iovec iov[1] = {
+        { .iov_base = stream->_buf, .iov_len = (size_t)stream->_size },
+    };
+    _file_mut_stream_writev(stream, iov, 1);
+
+    stream->_flushed += stream->_size;
+    stream->_size = 0;
+}
+
+GEN_WRITE_METHOD_FOR(u8)
+GEN_WRITE_METHOD_FOR(i8)
+GEN_WRITE_METHOD_FOR(u16)
+GEN_WRITE_METHOD_FOR(i16)
+GEN_WRITE_METHOD_FOR(u32)
+GEN_WRITE_METHOD_FOR(i32)
+GEN_WRITE_METHOD_FOR(u64)
+GEN_WRITE_METHOD_FOR(i64)
+GEN_WRITE_METHOD_FOR(f32)
+GEN_WRITE_METHOD_FOR(f64)
+GEN_WRITE_METHOD_FOR(bool)
+
+GEN_WRITE_ARRAY_METHOD_FOR(u8)
+GEN_WRITE_ARRAY_METHOD_FOR(i8)
+GEN_WRITE_ARRAY_METHOD_FOR(u16)
+GEN_WRITE_ARRAY_METHOD_FOR(i16)
+GEN_WRITE_ARRAY_METHOD_FOR(u32)
+GEN_WRITE_ARRAY_METHOD_FOR(i32)
+GEN_WRITE_ARRAY_METHOD_FOR(u64)
+GEN_WRITE_ARRAY_METHOD_FOR(i64)
+GEN_WRITE_ARRAY_METHOD_FOR(f32)
+GEN_WRITE_ARRAY_METHOD_FOR(f64)
+GEN_WRITE_ARRAY_METHOD_FOR(bool)
+
+/****************************************************
+ *              PUBLIC METHODS END.                 *
+ ****************************************************/
+
+/****************************************************
+ *              PRIVATE METHODS START.              *
+ ****************************************************/
+
+static inline FileMutStreamWriteBytesFn
+_file_mut_stream_find_write_bytes_impl(StreamEndian endian)
+{
+    return endian == MACHINE_ENDIAN ? _file_mut_stream_write_straight_bytes
+                                    : _file_mut_stream_write_reverse_bytes;
+}
+
+static void _file_mut_stream_write_straight_bytes(FileMutStream* stream,
+                                                  u8 const* src, u64 size)
+{
+    if (stream->_size + size > stream->_capacity) {
+        _file_mut_stream_write_slow(stream, src, size);
+        return;
+    }
+
+    memcpy(stream->_buf + stream->_size, src, size);
+    stream->_size += size;
+}
+
+static void _file_mut_stream_write_reverse_bytes(FileMutStream* stream,
+                                                 u8 const* src, u64 size)
+{
+    for (u64 i = 0; i < size; ++i) {
+        if (stream->_size == stream->_capacity) {
+            file_mut_stream_flush(stream);
+        }
+        stream->_buf[stream->_size++] = src[size - i - 1];
+    }
+}
+
+static void _file_mut_stream_write_slow(FileMutStream* stream, u8 const* src,
+                                        u64 size)
+{
+    // Big payload is written together with buffer by one writev call.
+    if (size >= stream->_capacity) {
+        struct iovec iov[2] = {
+            { .iov_base = stream->_buf, .iov_len = (size_t)stream->_size },
+            { .iov_base = (void*)(uintptr_t)src, .iov_len = (size_t)size },
+        };
+        _file_mut_stream_writev(stream, iov, 2);
+
+        stream->_flushed += stream->_size + size;
+        stream->_size = 0;
+        return;
+    }
+
+    // Otherwise fill buffer up, flush it and keep the rest.
+    u64 head = stream->_capacity - stream->_size;
+    memcpy(stream->_buf + stream->_size, src, head);
+    stream->_size = stream->_capacity;
+    file_mut_stream_flush(stream);
+
+    memcpy(stream->_buf, src + head, size - head);
+    stream->_size = size - head;
+}
+
+static void _file_mut_stream_write_array(FileMutStream* stream, u8 const* src,
+                                         u64 count, u64 item_size)
+{
+    if (stream->_endian == MACHINE_ENDIAN or item_size == 1) {
+        _file_mut_stream_write_straight_bytes(stream, src, count * item_size);
+        return;
+    }
+
+    // Item doesn't fit into tiny buffer, reverse it byte by byte.
+    if (stream->_capacity < item_size) {
+        for (u64 i = 0; i < count; ++i) {
+            _file_mut_stream_write_reverse_bytes(stream, src + i * item_size,
+                                                 item_size);
+        }
+        return;
+    }
+
+    // Swap bytes right into buffer by chunks which fit into it.
+    while (count > 0) {
+        u64 free_items = (stream->_capacity - stream->_size) / item_size;
+        if (free_items == 0) {
+            file_mut_stream_flush(stream);
+            continue;
+        }
+
+        u64 chunk = free_items < count ? free_items : count;
+        _streams_copy_swapped(stream->_buf + stream->_size, src, chunk,
+                              item_size);
+        stream->_size += chunk * item_size;
+        src += chunk * item_size;
+        count -= chunk;
+    }
+}
+
+static void _file_mut_stream_writev(FileMutStream* stream, struct iovec* iov,
+                                    int iov_count)
+{
+    while (iov_count > 0) {
+        ssize_t res = writev(stream->_fd, iov, iov_count);
+
+        if (res < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            panic("Error: can't write file stream: %s.\n", strerror(errno));
+        }
+
+        // Skip written bytes in case of partial write.
+        size_t written = (size_t)res;
+        while (iov_count > 0 and written >= iov->iov_len) {
+            written -= iov->iov_len;
+            ++iov;
+            --iov_count;
+        }
+        if (iov_count > 0) {
+            iov->iov_base = (u8*)iov->iov_base + written;
+            iov->iov_len -= written;
+        }
+    }
+}
+
+/****************************************************
+ *              PRIVATE METHODS END.                *
+ ****************************************************/
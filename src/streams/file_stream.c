@@ -0,0 +1,366 @@
+// off_t and ssize_t are hidden by strict c2x mode, 64 bit off_t is needed for
+// big files on 32 bit systems.
+#define _DEFAULT_SOURCE
+#define _FILE_OFFSET_BITS 64
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "nclib/panic.h"
+#include "nclib/streams/_streams_bswap.h"
+#include "nclib/streams/file_stream.h"
+
+/********************************************
+ *              DEFINES START.              *
+ ********************************************/
+
+#define GEN_READ_METHOD_FOR(_type_)                                           \
+    _type_ file_stream_read_##_type_(FileStream* stream)                      \
+    {                                                                         \
+        _type_ buf;                                                           \
+        stream->_read_bytes_impl(stream, (u8*)(&buf), sizeof buf);            \
+        return buf;                                                           \
+    }
+
+#define GEN_READ_ARRAY_METHOD_FOR(_type_)                                     \
+    void file_stream_read_##_type_##_array(FileStream* stream, _type_* dst,   \
+                                           u64 count)                         \
+    {                                                                         \
+        _file_stream_read_array(stream, (u8*)dst, count, sizeof(_type_));     \
+    }
+
+/********************************************
+ *              DEFINES END.                *
+ ********************************************/
+
+/****************************************************************
+ *              PRIVATE METHODS SIGNATURE START.                *
+ ****************************************************************/
+
+static inline FileStreamReadBytesFn
+_file_stream_find_read_bytes_impl(StreamEndian endian);
+static void _file_stream_read_straight_bytes(FileStream* stream, u8* dst,
+                                             u64 size);
+static void _file_stream_read_reverse_bytes(FileStream* stream, u8* dst,
+                                            u64 size);
+static void _file_stream_read_slow(FileStream* stream, u8* dst, u64 size);
+static void _file_stream_read_array(FileStream* stream, u8* dst, u64 count,
+                                    u64 item_size);
+
+static void _file_stream_refill(FileStream* stream);
+static u64 _file_stream_read_fd(int fd, u8* dst, u64 size);
+static void _file_stream_out_of_bound(FileStream* stream, u8* dst, u64 size);
+
+static u64 _file_stream_new_offset_from_start(i64 offset, u64 stream_size);
+static u64 _file_stream_new_offset_from_cur(i64 offset, u64 stream_size,
+                                            u64 curr_offset);
+static u64 _file_stream_new_offset_from_end(i64 offset, u64 stream_size);
+
+/************************************************************
+ *              PRIVATE METHODS SIGNATURE END.              *
+ ************************************************************/
+
+/****************************************************
+ *              PUBLIC METHODS START.               *
+ ****************************************************/
+
+FileStream file_stream_new(int fd, u64 window_size, StreamEndian endian)
+{
+    if (window_size == 0) {
+        window_size = FILE_STREAM_DEFAULT_WINDOW_SIZE;
+    }
+
+    u8* window = malloc(window_size);
+    if (window == NULL) {
+        panic("Error: can't allocate %lu bytes for file stream window.\n",
+              window_size);
+    }
+
+    struct stat st;
+    u64 size = fstat(fd, &st) == 0 ? (u64)st.st_size : 0;
+
+    // Reading begins at current position of fd, but offsets are absolute
+    // file offsets (position of not seekable fd is 0).
+    off_t start = lseek(fd, 0, SEEK_CUR);
+
+    return (FileStream) {
+        ._fd = fd,
+        ._window = window,
+        ._window_capacity = window_size,
+        ._window_size = 0,
+        ._window_offset = 0,
+        ._window_start = start < 0 ? 0 : (u64)start,
+        ._size = size,
+        ._endian = endian,
+        ._read_bytes_impl = _file_stream_find_read_bytes_impl(endian),
+    };
+}
+
+FileStream file_stream_new_be(int fd, u64 window_size)
+{
+    return file_stream_new(fd, window_size, STREAM_BIG_ENDIAN);
+}
+
+FileStream file_stream_new_le(int fd, u64 window_size)
+{
+    return file_stream_new(fd, window_size, STREAM_LITTLE_ENDIAN);
+}
+
+void file_stream_free(FileStream* stream)
+{
+    free(stream->_window);
+    stream->_window = NULL;
+    stream->_window_capacity = 0;
+    stream->_window_size = 0;
+    stream->_window_offset = 0;
+}
+
+void file_stream_read_bytes(FileStream* stream, u8* bytes, u64 size)
+{
+    _file_stream_read_straight_bytes(stream, bytes, size);
+}
+
+u64 file_stream_seek(FileStream* stream, i64 offset, StreamWhence whence)
+{
+    u64 curr_offset = file_stream_tell(stream);
+    u64 new_offset;
+
+    if (whence == STREAM_START) {
+        new_offset = _file_stream_new_offset_from_start(offset, stream->_size);
+    }
+    else if (whence == STREAM_CURR) {
+        new_offset = _file_stream_new_offset_from_cur(offset, stream->_size,
+                                                      curr_offset);
+    }
+    else {
+        new_offset = _file_stream_new_offset_from_end(offset, stream->_size);
+    }
+
+    // Reuse window if new offset is inside it.
+    if (new_offset >= stream->_window_start
+        and new_offset <= stream->_window_start + stream->_window_size) {
+        stream->_window_offset = new_offset - stream->_window_start;
+        return new_offset;
+    }
+
+    if (lseek(stream->_fd, (off_t)new_offset, SEEK_SET) < 0) {
+        panic("Error: can't seek file stream: %s.\n", strerror(errno));
+    }
+
+    stream->_window_start = new_offset;
+    stream->_window_size = 0;
+    stream->_window_offset = 0;
+
+    return new_offset;
+}
+
+GEN_READ_METHOD_FOR(u8)
+GEN_READ_METHOD_FOR(i8)
+GEN_READ_METHOD_FOR(u16)
+GEN_READ_METHOD_FOR(i16)
+GEN_READ_METHOD_FOR(u32)
+GEN_READ_METHOD_FOR(i32)
+GEN_READ_METHOD_FOR(u64)
+GEN_READ_METHOD_FOR(i64)
+GEN_READ_METHOD_FOR(f32)
+GEN_READ_METHOD_FOR(f64)
+GEN_READ_METHOD_FOR(bool)
+
+GEN_READ_ARRAY_METHOD_FOR(u8)
+GEN_READ_ARRAY_METHOD_FOR(i8)
+GEN_READ_ARRAY_METHOD_FOR(u16)
+GEN_READ_ARRAY_METHOD_FOR(i16)
+GEN_READ_ARRAY_METHOD_FOR(u32)
+GEN_READ_ARRAY_METHOD_FOR(i32)
+GEN_READ_ARRAY_METHOD_FOR(u64)
+GEN_READ_ARRAY_METHOD_FOR(i64)
+GEN_READ_ARRAY_METHOD_FOR(f32)
+GEN_READ_ARRAY_METHOD_FOR(f64)
+GEN_READ_ARRAY_METHOD_FOR(bool)
+
+/****************************************************
+ *              PUBLIC METHODS END.                 *
+ ****************************************************/
+
+/****************************************************
+ *              PRIVATE METHODS START.              *
+ ****************************************************/
+
+static inline FileStreamReadBytesFn
+_file_stream_find_read_bytes_impl(StreamEndian endian)
+{
+    return endian == MACHINE_ENDIAN ? _file_stream_read_straight_bytes
+                                    : _file_stream_read_reverse_bytes;
+}
+
+static void _file_stream_read_straight_bytes(FileStream* stream, u8* dst,
+                                             u64 size)
+{
+    if (stream->_window_offset + size > stream->_window_size) {
+        _file_stream_read_slow(stream, dst, size);
+        return;
+    }
+
+    memcpy(dst, stream->_window + stream->_window_offset, size);
+    stream->_window_offset += size;
+}
+
+static void _file_stream_read_reverse_bytes(FileStream* stream, u8* dst,
+                                            u64 size)
+{
+    _file_stream_read_straight_bytes(stream, dst, size);
+
+    for (u64 i = 0; i < size / 2; ++i) {
+        u8 byte = dst[i];
+        dst[i] = dst[size - i - 1];
+        dst[size - i - 1] = byte;
+    }
+}
+
+static void _file_stream_read_slow(FileStream* stream, u8* dst, u64 size)
+{
+    u64 available = stream->_window_size - stream->_window_offset;
+
+    memcpy(dst, stream->_window + stream->_window_offset, available);
+    stream->_window_offset = stream->_window_size;
+    dst += available;
+    size -= available;
+
+    // Big reads go straight to destination without copying through window.
+    if (size >= stream->_window_capacity) {
+        u64 got = _file_stream_read_fd(stream->_fd, dst, size);
+        stream->_window_start += stream->_window_size + got;
+        stream->_window_size = 0;
+        stream->_window_offset = 0;
+
+        if (got < size) {
+            _file_stream_out_of_bound(stream, dst + got, size - got);
+        }
+        return;
+    }
+
+    _file_stream_refill(stream);
+
+    u64 got = size < stream->_window_size ? size : stream->_window_size;
+    memcpy(dst, stream->_window, got);
+    stream->_window_offset = got;
+
+    if (got < size) {
+        _file_stream_out_of_bound(stream, dst + got, size - got);
+    }
+}
+
+static void _file_stream_read_array(FileStream* stream, u8* dst, u64 count,
+                                    u64 item_size)
+{
+    _file_stream_read_straight_bytes(stream, dst, count * item_size);
+
+    if (stream->_endian != MACHINE_ENDIAN and item_size > 1) {
+        _streams_copy_swapped(dst, dst, count, item_size);
+    }
+}
+
+static void _file_stream_refill(FileStream* stream)
+{
+    stream->_window_start += stream->_window_size;
+    stream->_window_size = _file_stream_read_fd(
+        stream->_fd, stream->_window, stream->_window_capacity);
+    stream->_window_offset = 0;
+}
+
+static u64 _file_stream_read_fd(int fd, u8* dst, u64 size)
+{
+    u64 got = 0;
+
+    while (got < size) {
+        ssize_t res = read(fd, dst + got, (size_t)(size - got));
+
+        if (res == 0) {
+            break;
+        }
+        if (res < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            panic("Error: can't read file stream: %s.\n", strerror(errno));
+        }
+        got += (u64)res;
+    }
+
+    return got;
+}
+
+static void _file_stream_out_of_bound(FileStream* stream, u8* dst, u64 size)
+{
+#ifdef CHECK_BOUND
+    panic("Error: file stream access out of bound. Size=%lu, access by "
+          "index=%lu.\n",
+          stream->_size, file_stream_tell(stream) + size);
+#else
+    (void)stream;
+#endif
+
+    // Bytes after end of file are read as zeros.
+    memset(dst, 0, size);
+}
+
+static u64 _file_stream_new_offset_from_start(i64 offset, u64 stream_size)
+{
+    bool offset_negative = offset < 0;
+
+    if (offset_negative) {
+        return 0;
+    }
+
+    if ((u64)offset > stream_size) {
+        return stream_size;
+    }
+
+    return (u64)offset;
+}
+
+static u64 _file_stream_new_offset_from_cur(i64 offset, u64 stream_size,
+                                            u64 curr_offset)
+{
+    bool offset_negative = offset < 0;
+
+    if (offset_negative) {
+        u64 offset_value = (u64)-offset;
+
+        if (offset_value > curr_offset) {
+            return 0;
+        }
+
+        return curr_offset - offset_value;
+    }
+
+    u64 offset_value = (u64)offset;
+
+    if (offset_value + curr_offset > stream_size) {
+        return stream_size;
+    }
+
+    return curr_offset + offset_value;
+}
+
+static u64 _file_stream_new_offset_from_end(i64 offset, u64 stream_size)
+{
+    bool offset_negative = offset < 0;
+
+    if (offset_negative) {
+        return stream_size;
+    }
+
+    if ((u64)offset > stream_size) {
+        return 0;
+    }
+
+    return stream_size - (u64)offset;
+}
+
+/****************************************************
+ *              PRIVATE METHODS END.                *
+ ****************************************************/
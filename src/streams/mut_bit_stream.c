@@ -0,0 +1,59 @@
+#include "nclib/streams/mut_bit_stream.h"
+
+/****************************************************
+ *              PUBLIC METHODS START.               *
+ ****************************************************/
+
+MutBitStream mut_bit_stream_new(u8* buf, u64 size, BitStreamOrder order)
+{
+    return (MutBitStream) {
+        ._buf = buf,
+        ._size = size,
+        ._offset = 0,
+        ._bits = 0,
+        ._count = 0,
+        ._order = order,
+    };
+}
+
+MutBitStream mut_bit_stream_new_msb(u8* buf, u64 size)
+{
+    return mut_bit_stream_new(buf, size, BIT_STREAM_MSB_FIRST);
+}
+
+MutBitStream mut_bit_stream_new_lsb(u8* buf, u64 size)
+{
+    return mut_bit_stream_new(buf, size, BIT_STREAM_LSB_FIRST);
+}
+
+void mut_bit_stream_flush(MutBitStream* stream)
+{
+    if (stream->_count == 0) {
+        return;
+    }
+
+    // Unused bits of buffer are zeros, so incomplete byte is padded by them.
+    stream->_count = (stream->_count + 7) & ~(u32)7;
+    _mut_bit_stream_store_slow(stream);
+}
+
+void _mut_bit_stream_store_slow(MutBitStream* stream)
+{
+    while (stream->_count >= 8) {
+        STREAM_CHECK_BOUND(stream, 1);
+
+        if (stream->_order == BIT_STREAM_LSB_FIRST) {
+            stream->_buf[stream->_offset++] = (u8)stream->_bits;
+            stream->_bits >>= 8;
+        }
+        else {
+            stream->_buf[stream->_offset++] = (u8)(stream->_bits >> 56);
+            stream->_bits <<= 8;
+        }
+        stream->_count -= 8;
+    }
+}
+
+/****************************************************
+ *              PUBLIC METHODS END.                 *
+ ****************************************************/
@@ -1,6 +1,9 @@
+#include <stdlib.h>
 #include <string.h>
 
+#include "nclib/streams/_streams_bswap.h"
 #include "nclib/streams/_streams_check_bound.h"
+#include "nclib/panic.h"
 #include "nclib/streams/mut_stream.h"
 
 /********************************************
@@ -21,6 +24,21 @@
         stream->_write_bytes_impl(stream, (u8*)(&buf), sizeof buf);           \
     }
 
+#define GEN_READ_ARRAY_METHOD_FOR(_type_)                                     \
+    void mut_stream_read_##_type_##_array(MutStream* stream, _type_* dst,     \
+                                          u64 count)                          \
+    {                                                                         \
+        _mut_stream_read_array(stream, (u8*)dst, count, sizeof(_type_));      \
+    }
+
+#define GEN_WRITE_ARRAY_METHOD_FOR(_type_)                                    \
+    void mut_stream_write_##_type_##_array(MutStream* stream,                 \
+                                           _type_ const* src, u64 count)      \
+    {                                                                         \
+        _mut_stream_write_array(stream, (u8 const*)src, count,                \
+                                sizeof(_type_));                              \
+    }
+
 /********************************************
  *              DEFINES END.                *
  ********************************************/
@@ -35,6 +53,8 @@ static void _mut_stream_read_straight_bytes(MutStream* stream, u8* dst,
                                             u64 size);
 static void _mut_stream_read_reverse_bytes(MutStream* stream, u8* dst,
                                            u64 size);
+static void _mut_stream_read_array(MutStream* stream, u8* dst, u64 count,
+                                   u64 item_size);
 
 static inline MutStreamWriteBytesFn
 _mut_stream_find_write_bytes_impl(StreamEndian endian);
@@ -42,6 +62,10 @@ static void _mut_stream_write_straight_bytes(MutStream* stream, const u8* src,
                                              u64 size);
 static void _mut_stream_write_reverse_bytes(MutStream* stream, const u8* src,
                                             u64 size);
+static void _mut_stream_write_array(MutStream* stream, u8 const* src,
+                                    u64 count, u64 item_size);
+
+static void _mut_stream_grow(MutStream* stream, u64 capacity);
 
 static u64 _mut_stream_new_offset_from_start(i64 offset, u64 stream_size);
 static u64 _mut_stream_new_offset_from_cur(i64 offset, u64 stream_size,
@@ -61,6 +85,9 @@ MutStream mut_stream_new(u8* buf, u64 buf_size, StreamEndian endian)
         ._buf = buf,
         ._size = buf_size,
         ._offset = 0,
+        ._endian = endian,
+        ._capacity = buf_size,
+        ._growable = false,
 
         ._read_bytes_impl = _mut_stream_find_read_bytes_impl(endian),
         ._write_bytes_impl = _mut_stream_find_write_bytes_impl(endian),
@@ -77,6 +104,77 @@ MutStream mut_stream_new_le(u8* buf, u64 buf_size)
     return mut_stream_new(buf, buf_size, STREAM_LITTLE_ENDIAN);
 }
 
+MutStream mut_stream_new_growable(u64 capacity, StreamEndian endian)
+{
+    MutStream stream = mut_stream_new(NULL, 0, endian);
+    stream._growable = true;
+    _mut_stream_grow(&stream, capacity);
+
+    return stream;
+}
+
+MutStream mut_stream_new_growable_be(u64 capacity)
+{
+    return mut_stream_new_growable(capacity, STREAM_BIG_ENDIAN);
+}
+
+MutStream mut_stream_new_growable_le(u64 capacity)
+{
+    return mut_stream_new_growable(capacity, STREAM_LITTLE_ENDIAN);
+}
+
+void mut_stream_reserve(MutStream* stream, u64 size)
+{
+    if (stream->_growable and stream->_offset + size > stream->_capacity) {
+        _mut_stream_grow(stream, stream->_offset + size);
+    }
+}
+
+u8* mut_stream_take(MutStream* stream, u64* size)
+{
+    u8* buf = stream->_buf;
+
+    if (size != NULL) {
+        *size = stream->_size;
+    }
+
+    if (stream->_growable) {
+        stream->_buf = NULL;
+        stream->_size = 0;
+        stream->_offset = 0;
+        stream->_capacity = 0;
+    }
+
+    return buf;
+}
+
+void mut_stream_free(MutStream* stream)
+{
+    if (stream->_growable) {
+        free(stream->_buf);
+    }
+
+    stream->_buf = NULL;
+    stream->_size = 0;
+    stream->_offset = 0;
+    stream->_capacity = 0;
+}
+
+void _mut_stream_extend(MutStream* stream, u64 size)
+{
+    if (not stream->_growable) {
+        STREAM_CHECK_BOUND(stream, size);
+        return;
+    }
+
+    u64 new_size = stream->_offset + size;
+    if (new_size > stream->_capacity) {
+        u64 capacity = stream->_capacity * 2;
+        _mut_stream_grow(stream, capacity > new_size ? capacity : new_size);
+    }
+    stream->_size = new_size;
+}
+
 void mut_stream_read_bytes(MutStream* stream, u8* bytes, u64 size)
 {
     _mut_stream_read_straight_bytes(stream, bytes, size);
@@ -87,6 +185,24 @@ void mut_stream_write_bytes(MutStream* stream, const u8* bytes, u64 size)
     _mut_stream_write_straight_bytes(stream, bytes, size);
 }
 
+void mut_stream_write_varint_u64(MutStream* stream, u64 num)
+{
+    u8 bytes[10];
+    u64 size = 0;
+
+    for (; num >= 0x80; num >>= 7) {
+        bytes[size++] = (u8)(num | 0x80);
+    }
+    bytes[size++] = (u8)num;
+
+    _mut_stream_write_straight_bytes(stream, bytes, size);
+}
+
+void mut_stream_write_varint_i64(MutStream* stream, i64 num)
+{
+    mut_stream_write_varint_u64(stream, ((u64)num << 1) ^ (u64)(num >> 63));
+}
+
 u64 mut_stream_seek(MutStream* stream, i64 offset, StreamWhence whence)
 {
     if (whence == STREAM_START) {
@@ -129,6 +245,30 @@ GEN_WRITE_METHOD_FOR(f32)
 GEN_WRITE_METHOD_FOR(f64)
 GEN_WRITE_METHOD_FOR(bool)
 
+GEN_READ_ARRAY_METHOD_FOR(u8)
+GEN_READ_ARRAY_METHOD_FOR(i8)
+GEN_READ_ARRAY_METHOD_FOR(u16)
+GEN_READ_ARRAY_METHOD_FOR(i16)
+GEN_READ_ARRAY_METHOD_FOR(u32)
+GEN_READ_ARRAY_METHOD_FOR(i32)
+GEN_READ_ARRAY_METHOD_FOR(u64)
+GEN_READ_ARRAY_METHOD_FOR(i64)
+GEN_READ_ARRAY_METHOD_FOR(f32)
+GEN_READ_ARRAY_METHOD_FOR(f64)
+GEN_READ_ARRAY_METHOD_FOR(bool)
+
+GEN_WRITE_ARRAY_METHOD_FOR(u8)
+GEN_WRITE_ARRAY_METHOD_FOR(i8)
+GEN_WRITE_ARRAY_METHOD_FOR(u16)
+GEN_WRITE_ARRAY_METHOD_FOR(i16)
+GEN_WRITE_ARRAY_METHOD_FOR(u32)
+GEN_WRITE_ARRAY_METHOD_FOR(i32)
+GEN_WRITE_ARRAY_METHOD_FOR(u64)
+GEN_WRITE_ARRAY_METHOD_FOR(i64)
+GEN_WRITE_ARRAY_METHOD_FOR(f32)
+GEN_WRITE_ARRAY_METHOD_FOR(f64)
+GEN_WRITE_ARRAY_METHOD_FOR(bool)
+
 /****************************************************
  *              PUBLIC METHODS END.                 *
  ****************************************************/
@@ -164,6 +304,23 @@ static void _mut_stream_read_reverse_bytes(MutStream* stream, u8* dst,
     stream->_offset += size;
 }
 
+static void _mut_stream_read_array(MutStream* stream, u8* dst, u64 count,
+                                   u64 item_size)
+{
+    u64 size = count * item_size;
+
+    STREAM_CHECK_BOUND(stream, size);
+
+    if (stream->_endian == MACHINE_ENDIAN) {
+        memcpy(dst, stream->_buf + stream->_offset, size);
+    }
+    else {
+        _streams_copy_swapped(dst, stream->_buf + stream->_offset, count,
+                              item_size);
+    }
+    stream->_offset += size;
+}
+
 static inline MutStreamWriteBytesFn
 _mut_stream_find_write_bytes_impl(StreamEndian endian)
 {
@@ -174,7 +331,7 @@ _mut_stream_find_write_bytes_impl(StreamEndian endian)
 static void _mut_stream_write_straight_bytes(MutStream* stream, const u8* src,
                                              u64 size)
 {
-    STREAM_CHECK_BOUND(stream, size);
+    _mut_stream_prepare_write(stream, size);
 
     memcpy(stream->_buf + stream->_offset, src, size);
     stream->_offset += size;
@@ -183,11 +340,45 @@ static void _mut_stream_write_straight_bytes(MutStream* stream, const u8* src,
 static void _mut_stream_write_reverse_bytes(MutStream* stream, const u8* src,
                                             u64 size)
 {
-    STREAM_CHECK_BOUND(stream, size);
+    _mut_stream_prepare_write(stream, size);
 
     for (u64 i = stream->_offset; i < stream->_offset + size; ++i) {
         stream->_buf[i] = src[size - (i - stream->_offset) - 1];
     }
+    stream->_offset += size;
+}
+
+static void _mut_stream_write_array(MutStream* stream, u8 const* src,
+                                    u64 count, u64 item_size)
+{
+    u64 size = count * item_size;
+
+    _mut_stream_prepare_write(stream, size);
+
+    if (stream->_endian == MACHINE_ENDIAN) {
+        memcpy(stream->_buf + stream->_offset, src, size);
+    }
+    else {
+        _streams_copy_swapped(stream->_buf + stream->_offset, src, count,
+                              item_size);
+    }
+    stream->_offset += size;
+}
+
+static void _mut_stream_grow(MutStream* stream, u64 capacity)
+{
+    if (capacity == 0) {
+        return;
+    }
+
+    u8* buf = realloc(stream->_buf, capacity);
+    if (buf == NULL) {
+        panic("Error: can't allocate %lu bytes for stream buffer.\n",
+              capacity);
+    }
+
+    stream->_buf = buf;
+    stream->_capacity = capacity;
 }
 
 static u64 _mut_stream_new_offset_from_start(i64 offset, u64 stream_size)
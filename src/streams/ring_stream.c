@@ -0,0 +1,188 @@
+#include <stdlib.h>
+
+#include "nclib/panic.h"
+#include "nclib/streams/_streams_bswap.h"
+#include "nclib/streams/ring_stream.h"
+
+/********************************************
+ *              DEFINES START.              *
+ ********************************************/
+
+// Every message starts with u32 size, messages are aligned by 8 bytes.
+#define RING_STREAM_HEADER_SIZE 4
+#define RING_STREAM_ALIGN 8
+
+// Size of message which means that rest of ring up to its end is skipped.
+#define RING_STREAM_WRAP 0xffffffffu
+
+#define RING_STREAM_MIN_CAPACITY 16
+
+/********************************************
+ *              DEFINES END.                *
+ ********************************************/
+
+/****************************************************************
+ *              PRIVATE METHODS SIGNATURE START.                *
+ ****************************************************************/
+
+static inline u64 _ring_stream_slot_size(u64 size);
+
+/************************************************************
+ *              PRIVATE METHODS SIGNATURE END.              *
+ ************************************************************/
+
+/****************************************************
+ *              PUBLIC METHODS START.               *
+ ****************************************************/
+
+RingStream ring_stream_new(u64 capacity, StreamEndian endian)
+{
+    if (capacity < RING_STREAM_MIN_CAPACITY
+        or (capacity & (capacity - 1)) != 0) {
+        panic("Error: ring stream capacity %lu is not power of two (at "
+              "least %d).\n",
+              capacity, RING_STREAM_MIN_CAPACITY);
+    }
+
+    u8* buf = malloc(capacity);
+    if (buf == NULL) {
+        panic("Error: can't allocate %lu bytes for ring stream.\n", capacity);
+    }
+
+    return (RingStream) {
+        ._head = 0,
+        ._write_pos = 0,
+        ._cached_tail = 0,
+        ._tail = 0,
+        ._read_pos = 0,
+        ._cached_head = 0,
+        ._buf = buf,
+        ._capacity = capacity,
+        ._endian = endian,
+    };
+}
+
+RingStream ring_stream_new_be(u64 capacity)
+{
+    return ring_stream_new(capacity, STREAM_BIG_ENDIAN);
+}
+
+RingStream ring_stream_new_le(u64 capacity)
+{
+    return ring_stream_new(capacity, STREAM_LITTLE_ENDIAN);
+}
+
+void ring_stream_free(RingStream* ring)
+{
+    free(ring->_buf);
+    ring->_buf = NULL;
+    ring->_capacity = 0;
+}
+
+bool ring_stream_try_write_begin(RingStream* ring, u64 max_size,
+                                 MutStream* message)
+{
+    u64 capacity = ring->_capacity;
+    u64 slot_size = _ring_stream_slot_size(max_size);
+
+    // Wrap marker stays until consumer passes it, so padding and slot of
+    // message up to half of ring always fit into empty ring.
+    if (max_size >= RING_STREAM_WRAP or slot_size > capacity / 2) {
+        panic("Error: message of %lu bytes doesn't fit half of ring stream "
+              "of %lu bytes.\n",
+              max_size, capacity);
+    }
+
+    // Message which doesn't fit before end of buffer starts from its
+    // beginning, skipped bytes are marked by wrap header.
+    u64 pos = ring->_write_pos;
+    u64 offset = pos & (capacity - 1);
+    u64 padding = slot_size > capacity - offset ? capacity - offset : 0;
+    u64 end = pos + padding + slot_size;
+
+    if (end - ring->_cached_tail > capacity) {
+        ring->_cached_tail = atomic_load_explicit(&ring->_tail,
+                                                  memory_order_acquire);
+        if (end - ring->_cached_tail > capacity) {
+            return false;
+        }
+    }
+
+    if (padding != 0) {
+        _streams_store_u32(ring->_buf + offset, RING_STREAM_WRAP,
+                           MACHINE_ENDIAN);
+        ring->_write_pos = pos + padding;
+        offset = 0;
+    }
+
+    *message = mut_stream_new(ring->_buf + offset + RING_STREAM_HEADER_SIZE,
+                              max_size, ring->_endian);
+    return true;
+}
+
+void ring_stream_write_commit(RingStream* ring, MutStream const* message)
+{
+    u64 pos = ring->_write_pos;
+    u64 size = mut_stream_tell(message);
+
+    _streams_store_u32(ring->_buf + (pos & (ring->_capacity - 1)), (u32)size,
+                       MACHINE_ENDIAN);
+    ring->_write_pos = pos + _ring_stream_slot_size(size);
+
+    // Release makes message bytes visible before new head.
+    atomic_store_explicit(&ring->_head, ring->_write_pos,
+                          memory_order_release);
+}
+
+bool ring_stream_try_read_begin(RingStream* ring, Stream* message)
+{
+    u64 pos = ring->_read_pos;
+
+    if (pos == ring->_cached_head) {
+        ring->_cached_head = atomic_load_explicit(&ring->_head,
+                                                  memory_order_acquire);
+        if (pos == ring->_cached_head) {
+            return false;
+        }
+    }
+
+    u64 offset = pos & (ring->_capacity - 1);
+    u32 size = _streams_load_u32(ring->_buf + offset, MACHINE_ENDIAN);
+
+    // Wrap header is published together with message after it.
+    if (size == RING_STREAM_WRAP) {
+        pos += ring->_capacity - offset;
+        offset = 0;
+        size = _streams_load_u32(ring->_buf, MACHINE_ENDIAN);
+    }
+
+    *message = stream_new(ring->_buf + offset + RING_STREAM_HEADER_SIZE, size,
+                          ring->_endian);
+    ring->_read_pos = pos + _ring_stream_slot_size(size);
+    return true;
+}
+
+void ring_stream_read_commit(RingStream* ring)
+{
+    // Release keeps reads of messages before producer reuses their space.
+    atomic_store_explicit(&ring->_tail, ring->_read_pos,
+                          memory_order_release);
+}
+
+/****************************************************
+ *              PUBLIC METHODS END.                 *
+ ****************************************************/
+
+/****************************************************
+ *              PRIVATE METHODS START.              *
+ ****************************************************/
+
+static inline u64 _ring_stream_slot_size(u64 size)
+{
+    return (RING_STREAM_HEADER_SIZE + size + RING_STREAM_ALIGN - 1)
+         & ~(u64)(RING_STREAM_ALIGN - 1);
+}
+
+/****************************************************
+ *              PRIVATE METHODS END.                *
+ ****************************************************/
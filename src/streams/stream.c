@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <string.h>
 
+#include "nclib/streams/_streams_bswap.h"
 #include "nclib/streams/_streams_check_bound.h"
 #include "nclib/streams/stream.h"
 
@@ -16,6 +17,13 @@
         return buf;                                                           \
     }
 
+#define GEN_READ_ARRAY_METHOD_FOR(_type_)                                     \
+    void stream_read_##_type_##_array(Stream* stream, _type_* dst,            \
+                                      u64 count)                              \
+    {                                                                         \
+        _stream_read_array(stream, (u8*)dst, count, sizeof(_type_));          \
+    }
+
 /********************************************
  *              DEFINES END.                *
  ********************************************/
@@ -28,6 +36,15 @@ static inline StreamReadBytesFn
 _stream_find_read_bytes_impl(StreamEndian endian);
 static void _stream_read_straight_bytes(Stream* stream, u8* dst, u64 size);
 static void _stream_read_reverse_bytes(Stream* stream, u8* dst, u64 size);
+static void _stream_read_straight_bytes_fallible(Stream* stream, u8* dst,
+                                                 u64 size);
+static void _stream_read_reverse_bytes_fallible(Stream* stream, u8* dst,
+                                                u64 size);
+static void _stream_read_array(Stream* stream, u8* dst, u64 count,
+                               u64 item_size);
+static u64 _stream_read_varint_fast(Stream* stream);
+static u64 _stream_read_varint_slow(Stream* stream);
+static inline u64 _stream_ctz_u64(u64 num);
 
 static u64 _stream_new_offset_from_start(i64 offset, u64 stream_size);
 static u64 _stream_new_offset_from_cur(i64 offset, u64 stream_size,
@@ -48,6 +65,7 @@ Stream stream_new(const u8* buf, u64 buf_size, StreamEndian endian)
         ._buf = buf,
         ._size = buf_size,
         ._offset = 0,
+        ._endian = endian,
         ._read_bytes_impl = _stream_find_read_bytes_impl(endian),
     };
 }
@@ -62,11 +80,86 @@ Stream stream_new_le(const u8* buf, u64 buf_size)
     return stream_new(buf, buf_size, STREAM_LITTLE_ENDIAN);
 }
 
+Stream stream_new_fallible(const u8* buf, u64 buf_size, StreamEndian endian)
+{
+    Stream stream = stream_new(buf, buf_size, endian);
+
+    stream._fallible = true;
+    stream._read_bytes_impl = endian == MACHINE_ENDIAN
+                                ? _stream_read_straight_bytes_fallible
+                                : _stream_read_reverse_bytes_fallible;
+
+    return stream;
+}
+
+Stream stream_new_fallible_be(const u8* buf, u64 buf_size)
+{
+    return stream_new_fallible(buf, buf_size, STREAM_BIG_ENDIAN);
+}
+
+Stream stream_new_fallible_le(const u8* buf, u64 buf_size)
+{
+    return stream_new_fallible(buf, buf_size, STREAM_LITTLE_ENDIAN);
+}
+
 void stream_read_bytes(Stream* stream, u8* bytes, u64 size)
 {
+    if (_stream_out_of_bound(stream, size)) {
+        memset(bytes, 0, size);
+        return;
+    }
+
     _stream_read_straight_bytes(stream, bytes, size);
 }
 
+StreamView stream_read_view(Stream* stream, u64 size)
+{
+    if (_stream_out_of_bound(stream, size)) {
+        return (StreamView) { .ptr = stream->_buf + stream->_size, .size = 0 };
+    }
+
+    STREAM_CHECK_BOUND(stream, size);
+
+    StreamView view = {
+        .ptr = stream->_buf + stream->_offset,
+        .size = size,
+    };
+    stream->_offset += size;
+
+    return view;
+}
+
+Stream stream_substream(Stream* stream, u64 size)
+{
+    StreamView view = stream_read_view(stream, size);
+
+    return (Stream) {
+        ._buf = view.ptr,
+        ._size = view.size,
+        ._offset = 0,
+        ._endian = stream->_endian,
+        ._fallible = stream->_fallible,
+        ._read_bytes_impl = stream->_read_bytes_impl,
+    };
+}
+
+u64 stream_read_varint_u64(Stream* stream)
+{
+    // Longest varint takes 10 bytes, so fast path can't read out of buffer.
+    if (stream->_size - stream->_offset >= 10) {
+        return _stream_read_varint_fast(stream);
+    }
+
+    return _stream_read_varint_slow(stream);
+}
+
+i64 stream_read_varint_i64(Stream* stream)
+{
+    u64 num = stream_read_varint_u64(stream);
+
+    return (i64)(num >> 1) ^ -(i64)(num & 1);
+}
+
 u64 stream_seek(Stream* stream, i64 offset, StreamWhence whence)
 {
     if (whence == STREAM_START) {
@@ -95,6 +188,18 @@ GEN_READ_METHOD_FOR(f32)
 GEN_READ_METHOD_FOR(f64)
 GEN_READ_METHOD_FOR(bool)
 
+GEN_READ_ARRAY_METHOD_FOR(u8)
+GEN_READ_ARRAY_METHOD_FOR(i8)
+GEN_READ_ARRAY_METHOD_FOR(u16)
+GEN_READ_ARRAY_METHOD_FOR(i16)
+GEN_READ_ARRAY_METHOD_FOR(u32)
+GEN_READ_ARRAY_METHOD_FOR(i32)
+GEN_READ_ARRAY_METHOD_FOR(u64)
+GEN_READ_ARRAY_METHOD_FOR(i64)
+GEN_READ_ARRAY_METHOD_FOR(f32)
+GEN_READ_ARRAY_METHOD_FOR(f64)
+GEN_READ_ARRAY_METHOD_FOR(bool)
+
 /****************************************************
  *              PUBLIC METHODS END.                 *
  ****************************************************/
@@ -129,6 +234,116 @@ static void _stream_read_reverse_bytes(Stream* stream, u8* dst, u64 size)
     stream->_offset += size;
 }
 
+static void _stream_read_straight_bytes_fallible(Stream* stream, u8* dst,
+                                                 u64 size)
+{
+    if (_stream_out_of_bound(stream, size)) {
+        memset(dst, 0, size);
+        return;
+    }
+
+    _stream_read_straight_bytes(stream, dst, size);
+}
+
+static void _stream_read_reverse_bytes_fallible(Stream* stream, u8* dst,
+                                                u64 size)
+{
+    if (_stream_out_of_bound(stream, size)) {
+        memset(dst, 0, size);
+        return;
+    }
+
+    _stream_read_reverse_bytes(stream, dst, size);
+}
+
+static void _stream_read_array(Stream* stream, u8* dst, u64 count,
+                               u64 item_size)
+{
+    u64 size = count * item_size;
+
+    if (_stream_out_of_bound(stream, size)) {
+        memset(dst, 0, size);
+        return;
+    }
+
+    STREAM_CHECK_BOUND(stream, size);
+
+    if (stream->_endian == MACHINE_ENDIAN) {
+        memcpy(dst, stream->_buf + stream->_offset, size);
+    }
+    else {
+        _streams_copy_swapped(dst, stream->_buf + stream->_offset, count,
+                              item_size);
+    }
+    stream->_offset += size;
+}
+
+static u64 _stream_read_varint_fast(Stream* stream)
+{
+    u8 const* src = stream->_buf + stream->_offset;
+    u64 word = _streams_load_u64(src, STREAM_LITTLE_ENDIAN);
+    u64 stops = ~word & 0x8080808080808080u;
+
+    // Lowest stop bit marks last byte, mask keeps it and all bytes before.
+    u64 mask = stops == 0 ? ~(u64)0 : stops ^ (stops - 1);
+    u64 num = word & mask & 0x7f7f7f7f7f7f7f7fu;
+
+    // Squeeze 7 bit groups together: 8 x 7 -> 4 x 14 -> 2 x 28 -> 1 x 56.
+    num = ((num & 0x7f007f007f007f00u) >> 1) | (num & 0x007f007f007f007fu);
+    num = ((num & 0x3fff00003fff0000u) >> 2) | (num & 0x00003fff00003fffu);
+    num = ((num & 0x0fffffff00000000u) >> 4) | (num & 0x000000000fffffffu);
+
+    if (stops != 0) {
+        stream->_offset += _stream_ctz_u64(stops) / 8 + 1;
+        return num;
+    }
+
+    num |= (u64)(src[8] & 0x7f) << 56;
+    if ((src[8] & 0x80) == 0) {
+        stream->_offset += 9;
+        return num;
+    }
+
+    num |= (u64)src[9] << 63;
+    stream->_offset += 10;
+    return num;
+}
+
+static u64 _stream_read_varint_slow(Stream* stream)
+{
+    u64 num = 0;
+
+    for (u64 shift = 0; shift < 64; shift += 7) {
+        if (_stream_out_of_bound(stream, 1)) {
+            return 0;
+        }
+        STREAM_CHECK_BOUND(stream, 1);
+
+        u8 byte = stream->_buf[stream->_offset];
+        stream->_offset += 1;
+        num |= (u64)(byte & 0x7f) << shift;
+
+        if ((byte & 0x80) == 0) {
+            break;
+        }
+    }
+
+    return num;
+}
+
+static inline u64 _stream_ctz_u64(u64 num)
+{
+#if defined(__GNUC__)
+    return (u64)__builtin_ctzll(num);
+#else
+    u64 count = 0;
+    for (; (num & 1) == 0; num >>= 1) {
+        ++count;
+    }
+    return count;
+#endif
+}
+
 static u64 _stream_new_offset_from_start(i64 offset, u64 stream_size)
 {
     bool offset_negative = offset < 0;
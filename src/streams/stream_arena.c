@@ -0,0 +1,119 @@
+#include "nclib/panic.h"
+#include "nclib/streams/stream_arena.h"
+
+/********************************************
+ *              DEFINES START.              *
+ ********************************************/
+
+#define GEN_READ_ARRAY_ARENA_METHOD_FOR(_type_)                               \
+    _type_* stream_read_##_type_##_array_arena(Stream* stream, Arena* arena,  \
+                                               u64 count)                     \
+    {                                                                         \
+        if (not _stream_arena_has(stream, count, sizeof(_type_))) {           \
+            return NULL;                                                      \
+        }                                                                     \
+        _type_* dst = arena_new_array(arena, _type_, count);                  \
+        stream_read_##_type_##_array(stream, dst, count);                     \
+        return dst;                                                           \
+    }
+
+/********************************************
+ *              DEFINES END.                *
+ ********************************************/
+
+/****************************************************************
+ *              PRIVATE METHODS SIGNATURE START.                *
+ ****************************************************************/
+
+static bool _stream_arena_has(Stream* stream, u64 count, u64 item_size);
+
+/************************************************************
+ *              PRIVATE METHODS SIGNATURE END.              *
+ ************************************************************/
+
+/****************************************************
+ *              PUBLIC METHODS START.               *
+ ****************************************************/
+
+u8* stream_read_bytes_arena(Stream* stream, Arena* arena, u64 size)
+{
+    if (not _stream_arena_has(stream, size, 1)) {
+        return NULL;
+    }
+
+    u8* dst = arena_alloc_aligned(arena, size, 1);
+    stream_read_bytes(stream, dst, size);
+    return dst;
+}
+
+u8* stream_read_varbytes_arena(Stream* stream, Arena* arena, u64* size)
+{
+    *size = stream_read_varint_u64(stream);
+
+    // Don't trust length from stream, it can be huge.
+    if (not _stream_arena_has(stream, *size, 1)) {
+        *size = 0;
+    }
+
+    return stream_read_bytes_arena(stream, arena, *size);
+}
+
+char* stream_read_varstr_arena(Stream* stream, Arena* arena, u64* len)
+{
+    *len = stream_read_varint_u64(stream);
+
+    if (not _stream_arena_has(stream, *len, 1)) {
+        *len = 0;
+    }
+
+    // Extra byte for null terminator.
+    char* dst = arena_alloc_aligned(arena, *len + 1, 1);
+    stream_read_bytes(stream, (u8*)dst, *len);
+    dst[*len] = '\0';
+
+    return dst;
+}
+
+GEN_READ_ARRAY_ARENA_METHOD_FOR(u8)
+GEN_READ_ARRAY_ARENA_METHOD_FOR(i8)
+GEN_READ_ARRAY_ARENA_METHOD_FOR(u16)
+GEN_READ_ARRAY_ARENA_METHOD_FOR(i16)
+GEN_READ_ARRAY_ARENA_METHOD_FOR(u32)
+GEN_READ_ARRAY_ARENA_METHOD_FOR(i32)
+GEN_READ_ARRAY_ARENA_METHOD_FOR(u64)
+GEN_READ_ARRAY_ARENA_METHOD_FOR(i64)
+GEN_READ_ARRAY_ARENA_METHOD_FOR(f32)
+GEN_READ_ARRAY_ARENA_METHOD_FOR(f64)
+GEN_READ_ARRAY_ARENA_METHOD_FOR(bool)
+
+/****************************************************
+ *              PUBLIC METHODS END.                 *
+ ****************************************************/
+
+/****************************************************
+ *              PRIVATE METHODS START.              *
+ ****************************************************/
+
+/* Check that `count` items remain before anything is allocated for them.
+ * Short fallible stream gets error, short plain stream panics regardless of
+ * CHECK_BOUND option, because size from stream can overflow arena. */
+static bool _stream_arena_has(Stream* stream, u64 count, u64 item_size)
+{
+    u64 remains = stream->_size - stream->_offset;
+    if (count <= remains / item_size) {
+        return true;
+    }
+
+    if (not stream->_fallible) {
+        panic("Error: stream has %lu bytes left, can't read %lu items of %lu "
+              "bytes into arena.\n",
+              remains, count, item_size);
+    }
+    stream->_offset = stream->_size;
+    stream->_error = true;
+    return false;
+}
+
+/****************************************************
+ *              PRIVATE METHODS END.                *
+ ****************************************************/
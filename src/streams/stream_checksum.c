@@ -0,0 +1,83 @@
+#include "nclib/checksum/crc32c.h"
+#include "nclib/streams/stream_checksum.h"
+
+/****************************************************************
+ *              PRIVATE METHODS SIGNATURE START.                *
+ ****************************************************************/
+
+static void _stream_checksum_hash(StreamChecksum* checksum, u8 const* buf,
+                                  u64 offset);
+
+/************************************************************
+ *              PRIVATE METHODS SIGNATURE END.              *
+ ************************************************************/
+
+/****************************************************
+ *              PUBLIC METHODS START.               *
+ ****************************************************/
+
+StreamChecksum stream_checksum_begin(Stream const* stream)
+{
+    return (StreamChecksum) {
+        ._crc = 0,
+        ._offset = stream_tell(stream),
+    };
+}
+
+void stream_checksum_update(StreamChecksum* checksum, Stream const* stream)
+{
+    _stream_checksum_hash(checksum, stream_raw(stream), stream_tell(stream));
+}
+
+u32 stream_checksum_end(StreamChecksum* checksum, Stream const* stream)
+{
+    stream_checksum_update(checksum, stream);
+    return checksum->_crc;
+}
+
+StreamChecksum mut_stream_checksum_begin(MutStream const* stream)
+{
+    return (StreamChecksum) {
+        ._crc = 0,
+        ._offset = mut_stream_tell(stream),
+    };
+}
+
+void mut_stream_checksum_update(StreamChecksum* checksum,
+                                MutStream const* stream)
+{
+    // Growable stream may move its buffer, so only offset is kept.
+    _stream_checksum_hash(checksum, mut_stream_raw(stream),
+                          mut_stream_tell(stream));
+}
+
+u32 mut_stream_checksum_end(StreamChecksum* checksum,
+                            MutStream const* stream)
+{
+    mut_stream_checksum_update(checksum, stream);
+    return checksum->_crc;
+}
+
+/****************************************************
+ *              PUBLIC METHODS END.                 *
+ ****************************************************/
+
+/****************************************************
+ *              PRIVATE METHODS START.              *
+ ****************************************************/
+
+static void _stream_checksum_hash(StreamChecksum* checksum, u8 const* buf,
+                                  u64 offset)
+{
+    if (offset <= checksum->_offset) {
+        return;
+    }
+
+    checksum->_crc = crc32c(checksum->_crc, buf + checksum->_offset,
+                            offset - checksum->_offset);
+    checksum->_offset = offset;
+}
+
+/****************************************************
+ *              PRIVATE METHODS END.                *
+ ****************************************************/
@@ -0,0 +1,324 @@
+#include <string.h>
+
+#include "nclib/panic.h"
+#include "nclib/streams/_streams_bswap.h"
+#include "nclib/streams/_streams_check_bound.h"
+#include "nclib/streams/stream_columns.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define STREAMS_X86_SIMD
+#include <immintrin.h>
+#endif
+
+/********************************************
+ *              DEFINES START.              *
+ ********************************************/
+
+// Records are transposed by blocks, so block of input stays in L1 cache
+// while every column is filled from it.
+#define COLUMNS_BLOCK_RECORDS 256
+
+// Gather takes 32 bit indices, 8 records of block must fit them.
+#define COLUMNS_MAX_GATHER_STRIDE ((u64)1 << 24)
+
+#define GEN_COPY_LOOP_FOR(_bits_type_)                                        \
+    for (u64 i = 0; i < count; ++i) {                                         \
+        _bits_type_ num = _streams_load_##_bits_type_(src + i * src_step,     \
+                                                      MACHINE_ENDIAN);        \
+        if (swap) {                                                           \
+            num = _streams_bswap_##_bits_type_(num);                          \
+        }                                                                     \
+        _streams_store_##_bits_type_(dst + i * dst_step, num,                 \
+                                     MACHINE_ENDIAN);                         \
+    }
+
+/********************************************
+ *              DEFINES END.                *
+ ********************************************/
+
+#ifdef STREAMS_X86_SIMD
+// Per 128 bit lane masks which move field bytes of 4 gathered dwords into
+// low bytes of lane (and reverse them when endian differs).
+static u8 const _columns_shuffle_u8[16] = {
+    0, 4, 8, 12, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+};
+static u8 const _columns_shuffle_u16[16] = {
+    0, 1, 4, 5, 8, 9, 12, 13, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+};
+static u8 const _columns_shuffle_u16_swapped[16] = {
+    1, 0, 5, 4, 9, 8, 13, 12, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+};
+static u8 const _columns_shuffle_u32_swapped[16] = {
+    3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+};
+static u8 const _columns_shuffle_u64_swapped[16] = {
+    7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+};
+#endif
+
+/****************************************************************
+ *              PRIVATE METHODS SIGNATURE START.                *
+ ****************************************************************/
+
+static void _stream_columns_check_layout(StreamColumnsLayout layout);
+static void _stream_columns_copy_scalar(u8* dst, u64 dst_step, u8 const* src,
+                                        u64 src_step, u64 count,
+                                        u64 item_size, bool swap);
+static void _stream_columns_decode(StreamColumnsLayout layout,
+                                   void* const* columns, u8 const* src,
+                                   u64 count, bool swap);
+static void _stream_columns_encode(StreamColumnsLayout layout, u8* dst,
+                                   void const* const* columns, u64 count,
+                                   bool swap);
+
+#ifdef STREAMS_X86_SIMD
+static u8 const* _stream_columns_shuffle_mask(u64 item_size, bool swap);
+static u64 _stream_columns_gather_avx2(u8* dst, u8 const* src, u64 count,
+                                       u64 stride, u64 item_size, bool swap,
+                                       u8 const* end);
+#endif
+
+/************************************************************
+ *              PRIVATE METHODS SIGNATURE END.              *
+ ************************************************************/
+
+/****************************************************
+ *              PUBLIC METHODS START.               *
+ ****************************************************/
+
+u64 stream_columns_record_size(StreamColumnsLayout layout)
+{
+    u64 size = 0;
+
+    for (u64 k = 0; k < layout.count; ++k) {
+        size += layout.sizes[k];
+    }
+
+    return size;
+}
+
+void stream_read_columns(Stream* stream, StreamColumnsLayout layout,
+                         void* const* columns, u64 count)
+{
+    _stream_columns_check_layout(layout);
+
+    u64 size = count * stream_columns_record_size(layout);
+
+    if (_stream_out_of_bound(stream, size)) {
+        for (u64 k = 0; k < layout.count; ++k) {
+            memset(columns[k], 0, count * layout.sizes[k]);
+        }
+        return;
+    }
+    STREAM_CHECK_BOUND(stream, size);
+
+    _stream_columns_decode(layout, columns, stream->_buf + stream->_offset,
+                           count, stream->_endian != MACHINE_ENDIAN);
+    stream->_offset += size;
+}
+
+void mut_stream_write_columns(MutStream* stream, StreamColumnsLayout layout,
+                              void const* const* columns, u64 count)
+{
+    _stream_columns_check_layout(layout);
+
+    u64 size = count * stream_columns_record_size(layout);
+
+    _mut_stream_prepare_write(stream, size);
+    _stream_columns_encode(layout, stream->_buf + stream->_offset, columns,
+                           count, stream->_endian != MACHINE_ENDIAN);
+    stream->_offset += size;
+}
+
+/****************************************************
+ *              PUBLIC METHODS END.                 *
+ ****************************************************/
+
+/****************************************************
+ *              PRIVATE METHODS START.              *
+ ****************************************************/
+
+static void _stream_columns_check_layout(StreamColumnsLayout layout)
+{
+    for (u64 k = 0; k < layout.count; ++k) {
+        u8 size = layout.sizes[k];
+
+        if (size != 1 and size != 2 and size != 4 and size != 8) {
+            panic("Error: column field %lu has unsupported size %u.\n", k,
+                  size);
+        }
+    }
+}
+
+static void _stream_columns_copy_scalar(u8* dst, u64 dst_step, u8 const* src,
+                                        u64 src_step, u64 count,
+                                        u64 item_size, bool swap)
+{
+    if (item_size == 1) {
+        for (u64 i = 0; i < count; ++i) {
+            dst[i * dst_step] = src[i * src_step];
+        }
+    }
+    else if (item_size == 2) {
+        GEN_COPY_LOOP_FOR(u16)
+    }
+    else if (item_size == 4) {
+        GEN_COPY_LOOP_FOR(u32)
+    }
+    else {
+        GEN_COPY_LOOP_FOR(u64)
+    }
+}
+
+static void _stream_columns_decode(StreamColumnsLayout layout,
+                                   void* const* columns, u8 const* src,
+                                   u64 count, bool swap)
+{
+    u64 stride = stream_columns_record_size(layout);
+    u8 const* end = src + count * stride;
+
+    bool gather = false;
+#ifdef STREAMS_X86_SIMD
+    gather = __builtin_cpu_supports("avx2")
+         and stride <= COLUMNS_MAX_GATHER_STRIDE;
+#endif
+
+    for (u64 first = 0; first < count; first += COLUMNS_BLOCK_RECORDS) {
+        u64 block = count - first < COLUMNS_BLOCK_RECORDS
+                      ? count - first
+                      : COLUMNS_BLOCK_RECORDS;
+        u8 const* field = src + first * stride;
+
+        for (u64 k = 0; k < layout.count; ++k) {
+            u64 item_size = layout.sizes[k];
+            u8* dst = (u8*)columns[k] + first * item_size;
+            u64 done = 0;
+
+#ifdef STREAMS_X86_SIMD
+            if (gather) {
+                done = _stream_columns_gather_avx2(dst, field, block, stride,
+                                                   item_size, swap, end);
+            }
+#endif
+            _stream_columns_copy_scalar(dst + done * item_size, item_size,
+                                        field + done * stride, stride,
+                                        block - done, item_size, swap);
+            field += item_size;
+        }
+    }
+}
+
+static void _stream_columns_encode(StreamColumnsLayout layout, u8* dst,
+                                   void const* const* columns, u64 count,
+                                   bool swap)
+{
+    u64 stride = stream_columns_record_size(layout);
+
+    for (u64 first = 0; first < count; first += COLUMNS_BLOCK_RECORDS) {
+        u64 block = count - first < COLUMNS_BLOCK_RECORDS
+                      ? count - first
+                      : COLUMNS_BLOCK_RECORDS;
+        u8* field = dst + first * stride;
+
+        for (u64 k = 0; k < layout.count; ++k) {
+            u64 item_size = layout.sizes[k];
+            u8 const* src = (u8 const*)columns[k] + first * item_size;
+
+            _stream_columns_copy_scalar(field, stride, src, item_size, block,
+                                        item_size, swap);
+            field += item_size;
+        }
+    }
+}
+
+#ifdef STREAMS_X86_SIMD
+
+static u8 const* _stream_columns_shuffle_mask(u64 item_size, bool swap)
+{
+    if (item_size == 1) {
+        return _columns_shuffle_u8;
+    }
+    if (item_size == 2) {
+        return swap ? _columns_shuffle_u16_swapped : _columns_shuffle_u16;
+    }
+    if (item_size == 4) {
+        return swap ? _columns_shuffle_u32_swapped : NULL;
+    }
+    return swap ? _columns_shuffle_u64_swapped : NULL;
+}
+
+/* Gather field of 8 (or 4 for 8 byte field) records per step. Fields
+ * smaller than 4 bytes are gathered as dwords, so step stops while the last
+ * dword is inside `end`. Returns count of decoded records. */
+__attribute__((target("avx2"))) static u64
+_stream_columns_gather_avx2(u8* dst, u8 const* src, u64 count, u64 stride,
+                            u64 item_size, bool swap, u8 const* end)
+{
+    u8 const* mask = _stream_columns_shuffle_mask(item_size, swap);
+    __m256i shuffle = _mm256_setzero_si256();
+    if (mask != NULL) {
+        shuffle = _mm256_broadcastsi128_si256(
+            _mm_loadu_si128((__m128i const*)mask));
+    }
+
+    u64 left = (u64)(end - src);
+    u64 done = 0;
+
+    if (item_size == 8) {
+        __m256i index = _mm256_setr_epi64x(0, (i64)stride, (i64)(2 * stride),
+                                           (i64)(3 * stride));
+
+        for (; done + 4 <= count and (done + 3) * stride + 8 <= left;
+             done += 4) {
+            __m256i nums = _mm256_i64gather_epi64(
+                (long long const*)(src + done * stride), index, 1);
+            if (mask != NULL) {
+                nums = _mm256_shuffle_epi8(nums, shuffle);
+            }
+            _mm256_storeu_si256((__m256i*)(dst + done * 8), nums);
+        }
+
+        return done;
+    }
+
+    __m256i index = _mm256_mullo_epi32(
+        _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+        _mm256_set1_epi32((i32)stride));
+    // Moves packed low dwords of both lanes together.
+    __m256i compact = item_size == 1
+                        ? _mm256_setr_epi32(0, 4, 0, 0, 0, 0, 0, 0)
+                        : _mm256_setr_epi32(0, 1, 4, 5, 0, 0, 0, 0);
+
+    for (; done + 8 <= count and (done + 7) * stride + 4 <= left;
+         done += 8) {
+        __m256i nums = _mm256_i32gather_epi32(
+            (int const*)(src + done * stride), index, 1);
+        if (mask != NULL) {
+            nums = _mm256_shuffle_epi8(nums, shuffle);
+        }
+
+        if (item_size == 4) {
+            _mm256_storeu_si256((__m256i*)(dst + done * 4), nums);
+            continue;
+        }
+
+        nums = _mm256_permutevar8x32_epi32(nums, compact);
+        if (item_size == 2) {
+            _mm_storeu_si128((__m128i*)(dst + done * 2),
+                             _mm256_castsi256_si128(nums));
+        }
+        else {
+            _mm_storel_epi64((__m128i*)(dst + done),
+                             _mm256_castsi256_si128(nums));
+        }
+    }
+
+    return done;
+}
+
+#endif // endif STREAMS_X86_SIMD
+
+/****************************************************
+ *              PRIVATE METHODS END.                *
+ ****************************************************/
@@ -0,0 +1,688 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "nclib/panic.h"
+#include "nclib/streams/_streams_bswap.h"
+#include "nclib/streams/stream_lz4.h"
+
+/********************************************
+ *              DEFINES START.              *
+ ********************************************/
+
+#define LZ4_MIN_MATCH 4
+// Last match starts at least 12 bytes before end, last 5 bytes are literals.
+#define LZ4_MF_LIMIT 12
+#define LZ4_LAST_LITERALS 5
+#define LZ4_MAX_DISTANCE 65535
+#define LZ4_MAX_INPUT_SIZE 0x7e000000u
+
+#define LZ4_HASH_LOG 12
+// Every miss in a row grows step of search by 1 after 2^6 misses.
+#define LZ4_SKIP_TRIGGER 6
+
+#define LZ4_FRAME_MAGIC 0x184d2204u
+#define LZ4_FRAME_VERSION 0x40
+#define LZ4_FRAME_INDEPENDENT 0x20
+#define LZ4_FRAME_BLOCK_CHECKSUM 0x10
+#define LZ4_FRAME_CONTENT_SIZE 0x08
+#define LZ4_FRAME_CONTENT_CHECKSUM 0x04
+#define LZ4_FRAME_DICT_ID 0x01
+#define LZ4_FRAME_UNCOMPRESSED 0x80000000u
+// Block max size id 4 (64 KiB) in BD byte.
+#define LZ4_FRAME_BD_64KB 0x40
+
+/********************************************
+ *              DEFINES END.                *
+ ********************************************/
+
+/****************************************************************
+ *              PRIVATE METHODS SIGNATURE START.                *
+ ****************************************************************/
+
+static u64 _lz4_compress(u8* dst, u8 const* src, u64 size,
+                         u32 acceleration);
+static bool _lz4_decompress(u8 const* src, u64 src_size, u64 history,
+                            u8* dst, u64 dst_capacity, u64* produced);
+static inline u32 _lz4_hash(u8 const* src);
+static inline u64 _lz4_count(u8 const* src, u8 const* match,
+                             u8 const* limit);
+static inline u8* _lz4_write_length(u8* dst, u64 length);
+static inline bool _lz4_read_length(u8 const** src, u8 const* end,
+                                    u64* length);
+
+static void _stream_lz4_fail(Stream* stream, char const* reason);
+static inline bool _stream_lz4_has(Stream const* stream, u64 size);
+static bool _stream_read_lz4_block(Stream* stream, u64 compressed_size,
+                                   MutStream* dst, u64 max_size, u64 history,
+                                   u64* produced);
+
+static u64 _mut_stream_lz4_room(MutStream* stream, u64 size);
+static void _mut_stream_lz4_commit(MutStream* stream, u64 size);
+static void _mut_stream_lz4_frame_write_block(Lz4FrameWriter* writer,
+                                              MutStream* stream,
+                                              u8 const* src, u64 size);
+
+/************************************************************
+ *              PRIVATE METHODS SIGNATURE END.              *
+ ************************************************************/
+
+/****************************************************
+ *              PUBLIC METHODS START.               *
+ ****************************************************/
+
+u64 stream_lz4_compress_bound(u64 size) { return size + size / 255 + 16; }
+
+u64 mut_stream_write_lz4_block(MutStream* stream, u8 const* src, u64 size,
+                               u32 acceleration)
+{
+    u64 bound = stream_lz4_compress_bound(size);
+
+    // Compress right into stream buffer if worst case fits it.
+    if (_mut_stream_lz4_room(stream, bound) == bound) {
+        u64 compressed = _lz4_compress(stream->_buf + stream->_offset, src,
+                                       size, acceleration);
+        _mut_stream_lz4_commit(stream, compressed);
+        return compressed;
+    }
+
+    u8* buf = malloc(bound);
+    if (buf == NULL) {
+        panic("Error: can't allocate %lu bytes for lz4 block.\n", bound);
+    }
+
+    u64 compressed = _lz4_compress(buf, src, size, acceleration);
+    mut_stream_write_bytes(stream, buf, compressed);
+    free(buf);
+
+    return compressed;
+}
+
+u64 stream_read_lz4_block(Stream* stream, u64 compressed_size, MutStream* dst,
+                          u64 max_size)
+{
+    u64 produced = 0;
+
+    _stream_read_lz4_block(stream, compressed_size, dst, max_size, 0,
+                           &produced);
+    return produced;
+}
+
+Lz4FrameWriter mut_stream_lz4_frame_begin(MutStream* stream,
+                                          u32 acceleration)
+{
+    u8 header[7];
+
+    _streams_store_u32(header, LZ4_FRAME_MAGIC, STREAM_LITTLE_ENDIAN);
+    header[4] = LZ4_FRAME_VERSION | LZ4_FRAME_INDEPENDENT
+              | LZ4_FRAME_CONTENT_CHECKSUM;
+    header[5] = LZ4_FRAME_BD_64KB;
+    header[6] = (u8)(xxh32(0, header + 4, 2) >> 8);
+    mut_stream_write_bytes(stream, header, sizeof header);
+
+    return (Lz4FrameWriter) {
+        ._acceleration = acceleration,
+        ._checksum = xxh32_begin(0),
+    };
+}
+
+void mut_stream_lz4_frame_write(Lz4FrameWriter* writer, MutStream* stream,
+                                u8 const* src, u64 size)
+{
+    xxh32_update(&writer->_checksum, src, size);
+
+    while (size > 0) {
+        u64 block = size < STREAM_LZ4_FRAME_BLOCK_SIZE
+                      ? size
+                      : STREAM_LZ4_FRAME_BLOCK_SIZE;
+
+        _mut_stream_lz4_frame_write_block(writer, stream, src, block);
+        src += block;
+        size -= block;
+    }
+}
+
+void mut_stream_lz4_frame_end(Lz4FrameWriter* writer, MutStream* stream)
+{
+    u8 end[8];
+
+    _streams_store_u32(end, 0, STREAM_LITTLE_ENDIAN);
+    _streams_store_u32(end + 4, xxh32_end(&writer->_checksum),
+                       STREAM_LITTLE_ENDIAN);
+    mut_stream_write_bytes(stream, end, sizeof end);
+}
+
+Lz4FrameReader stream_lz4_frame_begin(Stream* stream)
+{
+    Lz4FrameReader reader = {
+        ._checksum = xxh32_begin(0),
+        ._done = true,
+    };
+
+    if (not _stream_lz4_has(stream, 7)) {
+        _stream_lz4_fail(stream, "truncated lz4 frame header");
+        return reader;
+    }
+
+    u8 const* header = stream->_buf + stream->_offset;
+    u8 flags = header[4];
+    u8 block_size_id = (header[5] >> 4) & 7;
+
+    if (_streams_load_u32(header, STREAM_LITTLE_ENDIAN) != LZ4_FRAME_MAGIC
+        or (flags & 0xc2) != LZ4_FRAME_VERSION
+        or (flags & LZ4_FRAME_DICT_ID) != 0 or (header[5] & 0x8f) != 0
+        or block_size_id < 4) {
+        _stream_lz4_fail(stream, "unsupported lz4 frame header");
+        return reader;
+    }
+
+    bool has_content_size = (flags & LZ4_FRAME_CONTENT_SIZE) != 0;
+    u64 header_size = has_content_size ? 15 : 7;
+
+    if (not _stream_lz4_has(stream, header_size)) {
+        _stream_lz4_fail(stream, "truncated lz4 frame header");
+        return reader;
+    }
+    if (header[header_size - 1]
+        != (u8)(xxh32(0, header + 4, header_size - 5) >> 8)) {
+        _stream_lz4_fail(stream, "wrong lz4 frame header checksum");
+        return reader;
+    }
+
+    reader._block_max_size = (u64)1 << (2 * block_size_id + 8);
+    reader._linked = (flags & LZ4_FRAME_INDEPENDENT) == 0;
+    reader._block_checksum = (flags & LZ4_FRAME_BLOCK_CHECKSUM) != 0;
+    reader._content_checksum = (flags & LZ4_FRAME_CONTENT_CHECKSUM) != 0;
+    reader._has_content_size = has_content_size;
+    if (has_content_size) {
+        reader._content_size = _streams_load_u64(header + 6,
+                                                 STREAM_LITTLE_ENDIAN);
+    }
+    reader._done = false;
+
+    stream->_offset += header_size;
+    return reader;
+}
+
+bool stream_lz4_frame_read_block(Lz4FrameReader* reader, Stream* stream,
+                                 MutStream* dst)
+{
+    if (reader->_done) {
+        return false;
+    }
+    reader->_done = true;
+
+    if (not _stream_lz4_has(stream, 4)) {
+        _stream_lz4_fail(stream, "truncated lz4 frame");
+        return false;
+    }
+
+    u32 block_header = _streams_load_u32(stream->_buf + stream->_offset,
+                                         STREAM_LITTLE_ENDIAN);
+    stream->_offset += 4;
+
+    if (block_header == 0) {
+        if (reader->_content_checksum) {
+            if (not _stream_lz4_has(stream, 4)) {
+                _stream_lz4_fail(stream, "truncated lz4 frame");
+                return false;
+            }
+            u32 checksum = _streams_load_u32(stream->_buf + stream->_offset,
+                                             STREAM_LITTLE_ENDIAN);
+            if (checksum != xxh32_end(&reader->_checksum)) {
+                _stream_lz4_fail(stream, "wrong lz4 frame checksum");
+                return false;
+            }
+            stream->_offset += 4;
+        }
+        if (reader->_has_content_size
+            and reader->_produced != reader->_content_size) {
+            _stream_lz4_fail(stream, "wrong lz4 frame content size");
+        }
+        return false;
+    }
+
+    u64 size = block_header & ~LZ4_FRAME_UNCOMPRESSED;
+    u64 checksum_size = reader->_block_checksum ? 4 : 0;
+
+    if (size > reader->_block_max_size
+        or not _stream_lz4_has(stream, size + checksum_size)) {
+        _stream_lz4_fail(stream, "wrong lz4 frame block size");
+        return false;
+    }
+
+    u8 const* block = stream->_buf + stream->_offset;
+    if (reader->_block_checksum
+        and xxh32(0, block, size)
+                != _streams_load_u32(block + size, STREAM_LITTLE_ENDIAN)) {
+        _stream_lz4_fail(stream, "wrong lz4 frame block checksum");
+        return false;
+    }
+
+    u64 produced = size;
+    if ((block_header & LZ4_FRAME_UNCOMPRESSED) != 0) {
+        if (_mut_stream_lz4_room(dst, size) != size) {
+            _stream_lz4_fail(stream, "too small lz4 output");
+            return false;
+        }
+        memcpy(dst->_buf + dst->_offset, block, size);
+        _mut_stream_lz4_commit(dst, size);
+        stream->_offset += size;
+    }
+    else if (not _stream_read_lz4_block(stream, size, dst,
+                                        reader->_block_max_size,
+                                        reader->_history, &produced)) {
+        return false;
+    }
+    stream->_offset += checksum_size;
+
+    if (reader->_content_checksum) {
+        xxh32_update(&reader->_checksum, dst->_buf + dst->_offset - produced,
+                     produced);
+    }
+    if (reader->_linked) {
+        reader->_history += produced;
+        if (reader->_history > LZ4_MAX_DISTANCE) {
+            reader->_history = LZ4_MAX_DISTANCE;
+        }
+    }
+    reader->_produced += produced;
+
+    reader->_done = false;
+    return true;
+}
+
+u64 stream_read_lz4_frame(Stream* stream, MutStream* dst)
+{
+    Lz4FrameReader reader = stream_lz4_frame_begin(stream);
+
+    while (stream_lz4_frame_read_block(&reader, stream, dst)) {
+    }
+
+    return reader._produced;
+}
+
+/****************************************************
+ *              PUBLIC METHODS END.                 *
+ ****************************************************/
+
+/****************************************************
+ *              PRIVATE METHODS START.              *
+ ****************************************************/
+
+static u64 _lz4_compress(u8* dst, u8 const* src, u64 size,
+                         u32 acceleration)
+{
+    if (size > LZ4_MAX_INPUT_SIZE) {
+        panic("Error: lz4 block can't be bigger than %u bytes, got %lu.\n",
+              LZ4_MAX_INPUT_SIZE, size);
+    }
+    if (acceleration == 0) {
+        acceleration = STREAM_LZ4_ACCELERATION_DEFAULT;
+    }
+
+    u8* op = dst;
+    u8 const* anchor = src;
+    u8 const* ip = src;
+
+    if (size < LZ4_MF_LIMIT + 1) {
+        goto last_literals;
+    }
+
+    // Positions of last seen 4 byte sequences, relative to src.
+    u32 table[1 << LZ4_HASH_LOG] = { 0 };
+    u8 const* mf_limit = src + size - LZ4_MF_LIMIT;
+    u8 const* match_limit = src + size - LZ4_LAST_LITERALS;
+
+    table[_lz4_hash(ip)] = 0;
+    ++ip;
+
+    for (;;) {
+        u8 const* match;
+        u8 const* next = ip;
+        u32 attempts = acceleration << LZ4_SKIP_TRIGGER;
+
+        do {
+            ip = next;
+            next = ip + (attempts++ >> LZ4_SKIP_TRIGGER);
+            if (next > mf_limit) {
+                goto last_literals;
+            }
+
+            u32 hash = _lz4_hash(ip);
+            match = src + table[hash];
+            table[hash] = (u32)(ip - src);
+        } while ((u64)(ip - match) > LZ4_MAX_DISTANCE
+                 or _streams_load_u32(match, MACHINE_ENDIAN)
+                        != _streams_load_u32(ip, MACHINE_ENDIAN));
+
+        while (ip > anchor and match > src and ip[-1] == match[-1]) {
+            --ip;
+            --match;
+        }
+
+        u64 literals = (u64)(ip - anchor);
+        u8* token = op++;
+        *token = (u8)((literals < 15 ? literals : 15) << 4);
+        if (literals >= 15) {
+            op = _lz4_write_length(op, literals - 15);
+        }
+        memcpy(op, anchor, literals);
+        op += literals;
+
+        for (;;) {
+            _streams_store_u16(op, (u16)(ip - match), STREAM_LITTLE_ENDIAN);
+            op += 2;
+
+            u64 length = _lz4_count(ip + LZ4_MIN_MATCH, match + LZ4_MIN_MATCH,
+                                    match_limit);
+            ip += length + LZ4_MIN_MATCH;
+            *token |= (u8)(length < 15 ? length : 15);
+            if (length >= 15) {
+                op = _lz4_write_length(op, length - 15);
+            }
+            anchor = ip;
+
+            if (ip >= mf_limit) {
+                goto last_literals;
+            }
+
+            table[_lz4_hash(ip - 2)] = (u32)(ip - 2 - src);
+
+            // Match right after match goes without literals.
+            u32 hash = _lz4_hash(ip);
+            match = src + table[hash];
+            table[hash] = (u32)(ip - src);
+            if ((u64)(ip - match) > LZ4_MAX_DISTANCE
+                or _streams_load_u32(match, MACHINE_ENDIAN)
+                       != _streams_load_u32(ip, MACHINE_ENDIAN)) {
+                break;
+            }
+
+            token = op++;
+            *token = 0;
+        }
+
+        ++ip;
+    }
+
+last_literals:;
+    u64 literals = (u64)(src + size - anchor);
+    *op++ = (u8)((literals < 15 ? literals : 15) << 4);
+    if (literals >= 15) {
+        op = _lz4_write_length(op, literals - 15);
+    }
+    memcpy(op, anchor, literals);
+    op += literals;
+
+    return (u64)(op - dst);
+}
+
+/* Safe decoder, never reads out of src and never writes out of dst. Copies
+ * go by 16 (literals) and 8 (matches) byte chunks while there is room for
+ * overrun, so they can write past end of sequence up to dst_capacity. */
+static bool _lz4_decompress(u8 const* src, u64 src_size, u64 history,
+                            u8* dst, u64 dst_capacity, u64* produced)
+{
+    u8 const* ip = src;
+    u8 const* ip_end = src + src_size;
+    u8* op = dst;
+    u8* op_end = dst + dst_capacity;
+
+    for (;;) {
+        if (ip >= ip_end) {
+            return false;
+        }
+
+        u8 token = *ip++;
+        u64 literals = token >> 4;
+
+        // Short sequence far from both ends: literals are one 16 byte copy
+        // and match of up to 18 bytes is copied by 8 + 8 + 2 bytes.
+        if (literals != 15 and ip_end - ip >= 32 and op_end - op >= 32) {
+            memcpy(op, ip, 16);
+            ip += literals;
+            op += literals;
+
+            u64 offset = _streams_load_u16(ip, STREAM_LITTLE_ENDIAN);
+            u64 length = token & 15;
+            if (length != 15 and offset >= 8
+                and offset <= (u64)(op - dst) + history) {
+                u8 const* match = op - offset;
+                memcpy(op, match, 8);
+                memcpy(op + 8, match + 8, 8);
+                memcpy(op + 16, match + 16, 2);
+                ip += 2;
+                op += length + LZ4_MIN_MATCH;
+                continue;
+            }
+
+            literals = 0;
+        }
+
+        if (literals == 15 and not _lz4_read_length(&ip, ip_end, &literals)) {
+            return false;
+        }
+        if (literals > (u64)(ip_end - ip) or literals > (u64)(op_end - op)) {
+            return false;
+        }
+
+        if ((u64)(ip_end - ip) >= literals + 16
+            and (u64)(op_end - op) >= literals + 16) {
+            for (u64 i = 0; i < literals; i += 16) {
+                memcpy(op + i, ip + i, 16);
+            }
+        }
+        else {
+            memcpy(op, ip, literals);
+        }
+        ip += literals;
+        op += literals;
+
+        // Last sequence has only literals.
+        if (ip == ip_end) {
+            break;
+        }
+        if (ip_end - ip < 2) {
+            return false;
+        }
+
+        u64 offset = _streams_load_u16(ip, STREAM_LITTLE_ENDIAN);
+        ip += 2;
+
+        u64 length = token & 15;
+        if (length == 15 and not _lz4_read_length(&ip, ip_end, &length)) {
+            return false;
+        }
+        length += LZ4_MIN_MATCH;
+
+        if (offset == 0 or offset > (u64)(op - dst) + history
+            or length > (u64)(op_end - op)) {
+            return false;
+        }
+
+        u8 const* match = op - offset;
+        u8* copy_end = op + length;
+
+        if ((u64)(op_end - op) < length + 8) {
+            for (; op < copy_end; ++op, ++match) {
+                *op = *match;
+            }
+            continue;
+        }
+
+        // Close match overlaps with output, so first 8 bytes go one by one.
+        // Then any multiple of offset not less than 8 repeats the same bytes.
+        if (offset < 8) {
+            for (u64 i = 0; i < 8; ++i) {
+                op[i] = match[i];
+            }
+            op += 8;
+            match = op - (offset * ((8 + offset - 1) / offset));
+        }
+        for (; op < copy_end; op += 8, match += 8) {
+            memcpy(op, match, 8);
+        }
+        op = copy_end;
+    }
+
+    *produced = (u64)(op - dst);
+    return true;
+}
+
+static inline u32 _lz4_hash(u8 const* src)
+{
+    return (_streams_load_u32(src, MACHINE_ENDIAN) * 2654435761u)
+        >> (32 - LZ4_HASH_LOG);
+}
+
+static inline u64 _lz4_count(u8 const* src, u8 const* match,
+                             u8 const* limit)
+{
+    u8 const* start = src;
+
+    while (src + 8 <= limit) {
+        u64 diff = _streams_load_u64(src, STREAM_LITTLE_ENDIAN)
+                 ^ _streams_load_u64(match, STREAM_LITTLE_ENDIAN);
+        if (diff != 0) {
+            return (u64)(src - start) + (u64)__builtin_ctzll(diff) / 8;
+        }
+        src += 8;
+        match += 8;
+    }
+    while (src < limit and *src == *match) {
+        ++src;
+        ++match;
+    }
+
+    return (u64)(src - start);
+}
+
+static inline u8* _lz4_write_length(u8* dst, u64 length)
+{
+    for (; length >= 255; length -= 255) {
+        *dst++ = 255;
+    }
+    *dst++ = (u8)length;
+
+    return dst;
+}
+
+static inline bool _lz4_read_length(u8 const** src, u8 const* end,
+                                    u64* length)
+{
+    u8 byte;
+
+    do {
+        if (*src >= end) {
+            return false;
+        }
+        byte = *(*src)++;
+        *length += byte;
+    } while (byte == 255);
+
+    return true;
+}
+
+static void _stream_lz4_fail(Stream* stream, char const* reason)
+{
+    if (not stream_is_fallible(stream)) {
+        panic("Error: %s at offset %lu.\n", reason, stream->_offset);
+    }
+
+    stream->_offset = stream->_size;
+    stream->_error = true;
+}
+
+static inline bool _stream_lz4_has(Stream const* stream, u64 size)
+{
+    return stream_ensure(stream, size);
+}
+
+static bool _stream_read_lz4_block(Stream* stream, u64 compressed_size,
+                                   MutStream* dst, u64 max_size, u64 history,
+                                   u64* produced)
+{
+    if (not _stream_lz4_has(stream, compressed_size)) {
+        _stream_lz4_fail(stream, "truncated lz4 block");
+        return false;
+    }
+
+    // History is output of previous blocks right before dst offset.
+    u64 room = _mut_stream_lz4_room(dst, max_size);
+    if (history > dst->_offset) {
+        history = dst->_offset;
+    }
+
+    if (not _lz4_decompress(stream->_buf + stream->_offset, compressed_size,
+                            history, dst->_buf + dst->_offset, room,
+                            produced)) {
+        _stream_lz4_fail(stream, "malformed lz4 block");
+        return false;
+    }
+
+    stream->_offset += compressed_size;
+    _mut_stream_lz4_commit(dst, *produced);
+    return true;
+}
+
+/* Bytes available for writing at offset (up to `size`), growable stream
+ * grows for them. */
+static u64 _mut_stream_lz4_room(MutStream* stream, u64 size)
+{
+    mut_stream_reserve(stream, size);
+
+    u64 end = stream->_growable ? stream->_capacity : stream->_size;
+    u64 room = end - stream->_offset;
+
+    return room < size ? room : size;
+}
+
+static void _mut_stream_lz4_commit(MutStream* stream, u64 size)
+{
+    _mut_stream_prepare_write(stream, size);
+    stream->_offset += size;
+}
+
+static void _mut_stream_lz4_frame_write_block(Lz4FrameWriter* writer,
+                                              MutStream* stream,
+                                              u8 const* src, u64 size)
+{
+    u64 bound = 4 + stream_lz4_compress_bound(size);
+    u8* buf = NULL;
+    u8* dst;
+
+    if (_mut_stream_lz4_room(stream, bound) == bound) {
+        dst = stream->_buf + stream->_offset;
+    }
+    else {
+        buf = malloc(bound);
+        if (buf == NULL) {
+            panic("Error: can't allocate %lu bytes for lz4 block.\n", bound);
+        }
+        dst = buf;
+    }
+
+    u64 compressed = _lz4_compress(dst + 4, src, size,
+                                   writer->_acceleration);
+    u32 block_header = (u32)compressed;
+
+    // Incompressible block is stored as is.
+    if (compressed >= size) {
+        memcpy(dst + 4, src, size);
+        compressed = size;
+        block_header = (u32)size | LZ4_FRAME_UNCOMPRESSED;
+    }
+    _streams_store_u32(dst, block_header, STREAM_LITTLE_ENDIAN);
+
+    if (buf != NULL) {
+        mut_stream_write_bytes(stream, buf, 4 + compressed);
+        free(buf);
+    }
+    else {
+        _mut_stream_lz4_commit(stream, 4 + compressed);
+    }
+}
+
+/****************************************************
+ *              PRIVATE METHODS END.                *
+ ****************************************************/
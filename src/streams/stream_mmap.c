@@ -0,0 +1,144 @@
+// madvise, MAP_POPULATE and ftruncate are hidden by strict c2x mode.
+#define _DEFAULT_SOURCE
+
+#include <fcntl.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "nclib/streams/stream_mmap.h"
+
+/****************************************************************
+ *              PRIVATE METHODS SIGNATURE START.                *
+ ****************************************************************/
+
+static bool _stream_mmap_fd(int fd, u64 size, int prot, StreamMmapFlags flags,
+                            u8** buf);
+static void _stream_munmap(u8 const* buf, u64 size);
+
+/************************************************************
+ *              PRIVATE METHODS SIGNATURE END.              *
+ ************************************************************/
+
+/****************************************************
+ *              PUBLIC METHODS START.               *
+ ****************************************************/
+
+bool stream_open_mmap(Stream* stream, char const* path, StreamEndian endian,
+                      StreamMmapFlags flags)
+{
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    u8* buf = NULL;
+    bool mapped = fstat(fd, &st) == 0
+        and _stream_mmap_fd(fd, (u64)st.st_size, PROT_READ, flags, &buf);
+    close(fd);
+
+    if (not mapped) {
+        return false;
+    }
+
+    *stream = stream_new(buf, (u64)st.st_size, endian);
+    return true;
+}
+
+void stream_close_mmap(Stream* stream)
+{
+    _stream_munmap(stream->_buf, stream->_size);
+    *stream = stream_new(NULL, 0, stream->_endian);
+}
+
+bool mut_stream_open_mmap(MutStream* stream, char const* path, u64 size,
+                          StreamEndian endian, StreamMmapFlags flags)
+{
+    int fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    bool ok = true;
+
+    if (size == 0) {
+        ok = fstat(fd, &st) == 0;
+        size = ok ? (u64)st.st_size : 0;
+    }
+    else {
+        ok = ftruncate(fd, (off_t)size) == 0;
+    }
+
+    u8* buf = NULL;
+    ok = ok
+        and _stream_mmap_fd(fd, size, PROT_READ | PROT_WRITE, flags, &buf);
+    close(fd);
+
+    if (not ok) {
+        return false;
+    }
+
+    *stream = mut_stream_new(buf, size, endian);
+    return true;
+}
+
+void mut_stream_close_mmap(MutStream* stream)
+{
+    _stream_munmap(stream->_buf, stream->_size);
+    *stream = mut_stream_new(NULL, 0, stream->_endian);
+}
+
+/****************************************************
+ *              PUBLIC METHODS END.                 *
+ ****************************************************/
+
+/****************************************************
+ *              PRIVATE METHODS START.              *
+ ****************************************************/
+
+static bool _stream_mmap_fd(int fd, u64 size, int prot, StreamMmapFlags flags,
+                            u8** buf)
+{
+    // mmap can't map zero bytes, empty file is just empty stream.
+    if (size == 0) {
+        *buf = NULL;
+        return true;
+    }
+
+    int map_flags = MAP_SHARED;
+#ifdef MAP_POPULATE
+    if (flags & STREAM_MMAP_POPULATE) {
+        map_flags |= MAP_POPULATE;
+    }
+#endif
+
+    void* addr = mmap(NULL, (size_t)size, prot, map_flags, fd, 0);
+    if (addr == MAP_FAILED) {
+        return false;
+    }
+
+    // Hints are optional, so their errors are ignored.
+    if (flags & STREAM_MMAP_SEQUENTIAL) {
+        madvise(addr, (size_t)size, MADV_SEQUENTIAL);
+    }
+    else if (flags & STREAM_MMAP_RANDOM) {
+        madvise(addr, (size_t)size, MADV_RANDOM);
+    }
+
+    *buf = addr;
+    return true;
+}
+
+static void _stream_munmap(u8 const* buf, u64 size)
+{
+    if (buf != NULL) {
+        munmap((void*)(uintptr_t)buf, (size_t)size);
+    }
+}
+
+/****************************************************
+ *              PRIVATE METHODS END.                *
+ ****************************************************/
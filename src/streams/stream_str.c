@@ -0,0 +1,28 @@
+#include "nclib/streams/stream_str.h"
+
+/****************************************************
+ *              PUBLIC METHODS START.               *
+ ****************************************************/
+
+StrView stream_read_str_view(Stream* stream)
+{
+    u64 len = stream_read_varint_u64(stream);
+    StreamView view = stream_read_view(stream, len);
+
+    return str_view_new((char const*)view.ptr, view.size);
+}
+
+Str stream_read_str(Stream* stream)
+{
+    return str_from_view(stream_read_str_view(stream));
+}
+
+void mut_stream_write_str_view(MutStream* stream, StrView view)
+{
+    mut_stream_write_varint_u64(stream, view.len);
+    mut_stream_write_bytes(stream, (u8 const*)view.ptr, view.len);
+}
+
+/****************************************************
+ *              PUBLIC METHODS END.                 *
+ ****************************************************/
@@ -0,0 +1,318 @@
+#include <string.h>
+
+#include "nclib/streams/_streams_check_bound.h"
+#include "nclib/streams/stream_vbyte.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define STREAMS_X86_SIMD
+#include <immintrin.h>
+#endif
+
+/********************************************
+ *              DEFINES START.              *
+ ********************************************/
+
+// Byte length of k-th number described by control byte c.
+#define VBYTE_LEN(c, k) ((u64)((((c) >> (2 * (k))) & 3) + 1))
+
+#define VBYTE_DATA_SIZE(c)                                                    \
+    (VBYTE_LEN(c, 0) + VBYTE_LEN(c, 1) + VBYTE_LEN(c, 2) + VBYTE_LEN(c, 3))
+
+#define VBYTE_SIZES_4(c)                                                      \
+    VBYTE_DATA_SIZE(c), VBYTE_DATA_SIZE(c + 1), VBYTE_DATA_SIZE(c + 2),       \
+        VBYTE_DATA_SIZE(c + 3)
+#define VBYTE_SIZES_16(c)                                                     \
+    VBYTE_SIZES_4(c), VBYTE_SIZES_4(c + 4), VBYTE_SIZES_4(c + 8),             \
+        VBYTE_SIZES_4(c + 12)
+#define VBYTE_SIZES_64(c)                                                     \
+    VBYTE_SIZES_16(c), VBYTE_SIZES_16(c + 16), VBYTE_SIZES_16(c + 32),        \
+        VBYTE_SIZES_16(c + 48)
+
+#ifdef STREAMS_X86_SIMD
+
+// Offset of k-th number inside data bytes of control byte c.
+#define VBYTE_OFFSET(c, k)                                                    \
+    (((k) > 0 ? VBYTE_LEN(c, 0) : 0) + ((k) > 1 ? VBYTE_LEN(c, 1) : 0)        \
+     + ((k) > 2 ? VBYTE_LEN(c, 2) : 0))
+
+// Shuffle index of j-th byte of k-th number, 0xff zeroes byte.
+#define VBYTE_SHUFFLE_BYTE(c, k, j)                                           \
+    ((j) < VBYTE_LEN(c, k) ? VBYTE_OFFSET(c, k) + (j) : 0xff)
+
+#define VBYTE_SHUFFLE_NUM(c, k)                                               \
+    VBYTE_SHUFFLE_BYTE(c, k, 0), VBYTE_SHUFFLE_BYTE(c, k, 1),                 \
+        VBYTE_SHUFFLE_BYTE(c, k, 2), VBYTE_SHUFFLE_BYTE(c, k, 3)
+
+#define VBYTE_SHUFFLE(c)                                                      \
+    {                                                                         \
+        VBYTE_SHUFFLE_NUM(c, 0), VBYTE_SHUFFLE_NUM(c, 1),                     \
+            VBYTE_SHUFFLE_NUM(c, 2), VBYTE_SHUFFLE_NUM(c, 3)                  \
+    }
+
+#define VBYTE_SHUFFLES_4(c)                                                   \
+    VBYTE_SHUFFLE(c), VBYTE_SHUFFLE(c + 1), VBYTE_SHUFFLE(c + 2),             \
+        VBYTE_SHUFFLE(c + 3)
+#define VBYTE_SHUFFLES_16(c)                                                  \
+    VBYTE_SHUFFLES_4(c), VBYTE_SHUFFLES_4(c + 4), VBYTE_SHUFFLES_4(c + 8),    \
+        VBYTE_SHUFFLES_4(c + 12)
+#define VBYTE_SHUFFLES_64(c)                                                  \
+    VBYTE_SHUFFLES_16(c), VBYTE_SHUFFLES_16(c + 16),                          \
+        VBYTE_SHUFFLES_16(c + 32), VBYTE_SHUFFLES_16(c + 48)
+
+#endif // endif STREAMS_X86_SIMD
+
+/********************************************
+ *              DEFINES END.                *
+ ********************************************/
+
+/* State of decoding, SIMD decoder handles full groups and scalar decoder
+ * continues from the place where it stopped. */
+typedef struct {
+    u8 const* ctrl;
+    u8 const* data;
+    u8 const* end;
+    u32* dst;
+    u64 count;
+    u32 prev;
+    bool delta;
+} VbyteDecoder;
+
+static u8 const _vbyte_data_sizes[256] = {
+    VBYTE_SIZES_64(0),
+    VBYTE_SIZES_64(64),
+    VBYTE_SIZES_64(128),
+    VBYTE_SIZES_64(192),
+};
+
+#ifdef STREAMS_X86_SIMD
+static u8 const _vbyte_shuffles[256][16] = {
+    VBYTE_SHUFFLES_64(0),
+    VBYTE_SHUFFLES_64(64),
+    VBYTE_SHUFFLES_64(128),
+    VBYTE_SHUFFLES_64(192),
+};
+#endif
+
+/****************************************************************
+ *              PRIVATE METHODS SIGNATURE START.                *
+ ****************************************************************/
+
+static void _stream_read_vbyte(Stream* stream, u32* dst, u64 count,
+                               bool delta, u32 prev);
+static void _mut_stream_write_vbyte(MutStream* stream, u32 const* src,
+                                    u64 count, bool delta, u32 prev);
+
+static u64 _vbyte_data_size(u8 const* ctrl, u64 count);
+static inline u8 _vbyte_len(u32 num);
+static void _vbyte_decode_scalar(VbyteDecoder* decoder);
+
+#ifdef STREAMS_X86_SIMD
+static void _vbyte_decode_ssse3(VbyteDecoder* decoder);
+#endif
+
+/************************************************************
+ *              PRIVATE METHODS SIGNATURE END.              *
+ ************************************************************/
+
+/****************************************************
+ *              PUBLIC METHODS START.               *
+ ****************************************************/
+
+u64 stream_vbyte_size_bound(u64 count) { return (count + 3) / 4 + count * 4; }
+
+void stream_read_vbyte_u32_array(Stream* stream, u32* dst, u64 count)
+{
+    _stream_read_vbyte(stream, dst, count, false, 0);
+}
+
+void stream_read_vbyte_u32_array_delta(Stream* stream, u32* dst, u64 count,
+                                       u32 prev)
+{
+    _stream_read_vbyte(stream, dst, count, true, prev);
+}
+
+void mut_stream_write_vbyte_u32_array(MutStream* stream, u32 const* src,
+                                      u64 count)
+{
+    _mut_stream_write_vbyte(stream, src, count, false, 0);
+}
+
+void mut_stream_write_vbyte_u32_array_delta(MutStream* stream, u32 const* src,
+                                            u64 count, u32 prev)
+{
+    _mut_stream_write_vbyte(stream, src, count, true, prev);
+}
+
+/****************************************************
+ *              PUBLIC METHODS END.                 *
+ ****************************************************/
+
+/****************************************************
+ *              PRIVATE METHODS START.              *
+ ****************************************************/
+
+static void _stream_read_vbyte(Stream* stream, u32* dst, u64 count,
+                               bool delta, u32 prev)
+{
+    u64 ctrl_size = (count + 3) / 4;
+    if (_stream_out_of_bound(stream, ctrl_size)) {
+        memset(dst, 0, count * sizeof *dst);
+        return;
+    }
+    STREAM_CHECK_BOUND(stream, ctrl_size);
+
+    u8 const* ctrl = stream->_buf + stream->_offset;
+    u64 size = ctrl_size + _vbyte_data_size(ctrl, count);
+    if (_stream_out_of_bound(stream, size)) {
+        memset(dst, 0, count * sizeof *dst);
+        return;
+    }
+    STREAM_CHECK_BOUND(stream, size);
+
+    VbyteDecoder decoder = {
+        .ctrl = ctrl,
+        .data = ctrl + ctrl_size,
+        .end = stream->_buf + stream->_size,
+        .dst = dst,
+        .count = count,
+        .prev = prev,
+        .delta = delta,
+    };
+
+#ifdef STREAMS_X86_SIMD
+    if (__builtin_cpu_supports("ssse3")) {
+        _vbyte_decode_ssse3(&decoder);
+    }
+#endif
+    _vbyte_decode_scalar(&decoder);
+
+    stream->_offset += size;
+}
+
+static void _mut_stream_write_vbyte(MutStream* stream, u32 const* src,
+                                    u64 count, bool delta, u32 prev)
+{
+    u64 ctrl_size = (count + 3) / 4;
+    u64 size = ctrl_size;
+
+    u32 last = prev;
+    for (u64 i = 0; i < count; ++i) {
+        u32 num = delta ? src[i] - last : src[i];
+        last = src[i];
+        size += _vbyte_len(num);
+    }
+
+    _mut_stream_prepare_write(stream, size);
+
+    u8* ctrl = stream->_buf + stream->_offset;
+    u8* data = ctrl + ctrl_size;
+
+    for (u64 i = 0; i < count; ++i) {
+        u32 num = delta ? src[i] - prev : src[i];
+        prev = src[i];
+
+        u8 len = _vbyte_len(num);
+        if (i % 4 == 0) {
+            ctrl[i / 4] = 0;
+        }
+        ctrl[i / 4] |= (u8)((len - 1) << (2 * (i % 4)));
+
+        for (u8 j = 0; j < len; ++j) {
+            data[j] = (u8)(num >> (8 * j));
+        }
+        data += len;
+    }
+
+    stream->_offset += size;
+}
+
+static u64 _vbyte_data_size(u8 const* ctrl, u64 count)
+{
+    u64 size = 0;
+
+    for (u64 i = 0; i < count / 4; ++i) {
+        size += _vbyte_data_sizes[ctrl[i]];
+    }
+    for (u64 k = 0; k < count % 4; ++k) {
+        size += VBYTE_LEN(ctrl[count / 4], k);
+    }
+
+    return size;
+}
+
+static inline u8 _vbyte_len(u32 num)
+{
+    return (u8)(1 + (num > 0xff) + (num > 0xffff) + (num > 0xffffff));
+}
+
+static void _vbyte_decode_scalar(VbyteDecoder* decoder)
+{
+    u8 const* data = decoder->data;
+    u32 prev = decoder->prev;
+
+    for (u64 i = 0; i < decoder->count; ++i) {
+        u64 len = VBYTE_LEN(decoder->ctrl[i / 4], i % 4);
+
+        u32 num = 0;
+        for (u64 j = 0; j < len; ++j) {
+            num |= (u32)data[j] << (8 * j);
+        }
+        data += len;
+
+        if (decoder->delta) {
+            num += prev;
+            prev = num;
+        }
+        decoder->dst[i] = num;
+    }
+
+    decoder->data = data;
+    decoder->dst += decoder->count;
+    decoder->ctrl += (decoder->count + 3) / 4;
+    decoder->count = 0;
+    decoder->prev = prev;
+}
+
+#ifdef STREAMS_X86_SIMD
+
+__attribute__((target("ssse3"))) static void
+_vbyte_decode_ssse3(VbyteDecoder* decoder)
+{
+    u8 const* ctrl = decoder->ctrl;
+    u8 const* data = decoder->data;
+    u32* dst = decoder->dst;
+    u64 groups = decoder->count / 4;
+    __m128i prev = _mm_set1_epi32((i32)decoder->prev);
+
+    // Every group loads 16 data bytes, so stop before end of buffer.
+    u64 group = 0;
+    for (; group < groups and data + 16 <= decoder->end; ++group) {
+        u8 c = ctrl[group];
+        __m128i shuffle = _mm_loadu_si128((__m128i const*)_vbyte_shuffles[c]);
+        __m128i nums = _mm_shuffle_epi8(
+            _mm_loadu_si128((__m128i const*)data), shuffle);
+
+        if (decoder->delta) {
+            nums = _mm_add_epi32(nums, _mm_slli_si128(nums, 4));
+            nums = _mm_add_epi32(nums, _mm_slli_si128(nums, 8));
+            nums = _mm_add_epi32(nums, prev);
+            prev = _mm_shuffle_epi32(nums, 0xff);
+        }
+
+        _mm_storeu_si128((__m128i*)dst, nums);
+        data += _vbyte_data_sizes[c];
+        dst += 4;
+    }
+
+    decoder->ctrl = ctrl + group;
+    decoder->data = data;
+    decoder->dst = dst;
+    decoder->count -= group * 4;
+    decoder->prev = (u32)_mm_cvtsi128_si32(prev);
+}
+
+#endif // endif STREAMS_X86_SIMD
+
+/****************************************************
+ *              PRIVATE METHODS END.                *
+ ****************************************************/
@@ -0,0 +1,155 @@
+#include <string.h>
+
+#include "nclib/streams/_streams_bswap.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define STREAMS_X86_SIMD
+#include <immintrin.h>
+#endif
+
+/****************************************************************
+ *              PRIVATE METHODS SIGNATURE START.                *
+ ****************************************************************/
+
+static void _streams_copy_swapped_scalar(u8* dst, u8 const* src, u64 count,
+                                         u64 item_size);
+
+#ifdef STREAMS_X86_SIMD
+static u8 const* _streams_shuffle_mask(u64 item_size);
+static void _streams_copy_swapped_ssse3(u8* dst, u8 const* src, u64 count,
+                                        u64 item_size);
+static void _streams_copy_swapped_avx2(u8* dst, u8 const* src, u64 count,
+                                       u64 item_size);
+#endif
+
+/************************************************************
+ *              PRIVATE METHODS SIGNATURE END.              *
+ ************************************************************/
+
+/****************************************************
+ *              PUBLIC METHODS START.               *
+ ****************************************************/
+
+void _streams_copy_swapped(u8* dst, u8 const* src, u64 count, u64 item_size)
+{
+    if (item_size == 1) {
+        memcpy(dst, src, count);
+        return;
+    }
+
+#ifdef STREAMS_X86_SIMD
+    if (__builtin_cpu_supports("avx2")) {
+        _streams_copy_swapped_avx2(dst, src, count, item_size);
+        return;
+    }
+    if (__builtin_cpu_supports("ssse3")) {
+        _streams_copy_swapped_ssse3(dst, src, count, item_size);
+        return;
+    }
+#endif
+
+    _streams_copy_swapped_scalar(dst, src, count, item_size);
+}
+
+/****************************************************
+ *              PUBLIC METHODS END.                 *
+ ****************************************************/
+
+/****************************************************
+ *              PRIVATE METHODS START.              *
+ ****************************************************/
+
+static void _streams_copy_swapped_scalar(u8* dst, u8 const* src, u64 count,
+                                         u64 item_size)
+{
+    if (item_size == 2) {
+        for (u64 i = 0; i < count; ++i) {
+            u16 num = _streams_load_u16(src + i * 2, MACHINE_ENDIAN);
+            _streams_store_u16(dst + i * 2, _streams_bswap_u16(num),
+                               MACHINE_ENDIAN);
+        }
+    }
+    else if (item_size == 4) {
+        for (u64 i = 0; i < count; ++i) {
+            u32 num = _streams_load_u32(src + i * 4, MACHINE_ENDIAN);
+            _streams_store_u32(dst + i * 4, _streams_bswap_u32(num),
+                               MACHINE_ENDIAN);
+        }
+    }
+    else {
+        for (u64 i = 0; i < count; ++i) {
+            u64 num = _streams_load_u64(src + i * 8, MACHINE_ENDIAN);
+            _streams_store_u64(dst + i * 8, _streams_bswap_u64(num),
+                               MACHINE_ENDIAN);
+        }
+    }
+}
+
+#ifdef STREAMS_X86_SIMD
+
+static u8 const* _streams_shuffle_mask(u64 item_size)
+{
+    static u8 const masks[3][16] = {
+        { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 },
+        { 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 },
+        { 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8 },
+    };
+
+    if (item_size == 2) {
+        return masks[0];
+    }
+    if (item_size == 4) {
+        return masks[1];
+    }
+    return masks[2];
+}
+
+__attribute__((target("ssse3"))) static void
+_streams_copy_swapped_ssse3(u8* dst, u8 const* src, u64 count, u64 item_size)
+{
+    __m128i mask
+        = _mm_loadu_si128((__m128i const*)_streams_shuffle_mask(item_size));
+    u64 size = count * item_size;
+    u64 i = 0;
+
+    for (; i + 16 <= size; i += 16) {
+        __m128i chunk = _mm_loadu_si128((__m128i const*)(src + i));
+        _mm_storeu_si128((__m128i*)(dst + i), _mm_shuffle_epi8(chunk, mask));
+    }
+
+    _streams_copy_swapped_scalar(dst + i, src + i, (size - i) / item_size,
+                                 item_size);
+}
+
+__attribute__((target("avx2"))) static void
+_streams_copy_swapped_avx2(u8* dst, u8 const* src, u64 count, u64 item_size)
+{
+    __m256i mask = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128((__m128i const*)_streams_shuffle_mask(item_size)));
+    u64 size = count * item_size;
+    u64 i = 0;
+
+    for (; i + 64 <= size; i += 64) {
+        __m256i first = _mm256_loadu_si256((__m256i const*)(src + i));
+        __m256i second = _mm256_loadu_si256((__m256i const*)(src + i + 32));
+        _mm256_storeu_si256((__m256i*)(dst + i),
+                            _mm256_shuffle_epi8(first, mask));
+        _mm256_storeu_si256((__m256i*)(dst + i + 32),
+                            _mm256_shuffle_epi8(second, mask));
+    }
+
+    for (; i + 32 <= size; i += 32) {
+        __m256i chunk = _mm256_loadu_si256((__m256i const*)(src + i));
+        _mm256_storeu_si256((__m256i*)(dst + i),
+                            _mm256_shuffle_epi8(chunk, mask));
+    }
+
+    _streams_copy_swapped_scalar(dst + i, src + i, (size - i) / item_size,
+                                 item_size);
+}
+
+#endif // endif STREAMS_X86_SIMD
+
+/****************************************************
+ *              PRIVATE METHODS END.                *
+ ****************************************************/
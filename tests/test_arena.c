@@ -0,0 +1,121 @@
+#include <stdint.h>
+#include <string.h>
+
+#include <criterion/criterion.h>
+#include <criterion/new/assert.h>
+
+#include "nclib/alloc/arena.h"
+
+Test(TestArena, test_arena_alloc)
+{
+    Arena arena = arena_new(0);
+
+    u8* first = arena_alloc(&arena, 10);
+    u8* second = arena_alloc(&arena, 10);
+    memset(first, 1, 10);
+    memset(second, 2, 10);
+
+    cr_assert(eq(u64, (uintptr_t)first % ARENA_DEFAULT_ALIGN, 0));
+    cr_assert(eq(u64, (uintptr_t)second % ARENA_DEFAULT_ALIGN, 0));
+    cr_assert(ge(u64, (uintptr_t)second, (uintptr_t)(first + 10)));
+    cr_assert(eq(u8, first[9], 1));
+
+    arena_free(&arena);
+}
+
+Test(TestArena, test_arena_alloc_aligned)
+{
+    Arena arena = arena_new(256);
+
+    arena_alloc_aligned(&arena, 1, 1);
+    u8* ptr = arena_alloc_aligned(&arena, 8, 64);
+    cr_assert(eq(u64, (uintptr_t)ptr % 64, 0));
+
+    u32* nums = arena_new_array(&arena, u32, 3);
+    cr_assert(eq(u64, (uintptr_t)nums % _Alignof(u32), 0));
+
+    arena_free(&arena);
+}
+
+Test(TestArena, test_arena_alloc_zeroed)
+{
+    Arena arena = arena_new(0);
+
+    u8* ptr = arena_alloc_zeroed(&arena, 100);
+    for (u64 i = 0; i < 100; ++i) {
+        cr_assert(eq(u8, ptr[i], 0));
+    }
+
+    arena_free(&arena);
+}
+
+Test(TestArena, test_arena_chained_blocks)
+{
+    Arena arena = arena_new(64);
+
+    u8* ptrs[20];
+    for (u64 i = 0; i < 20; ++i) {
+        ptrs[i] = arena_alloc(&arena, 40);
+        memset(ptrs[i], (int)i, 40);
+    }
+    // Allocation bigger than block gets own block.
+    u8* big = arena_alloc(&arena, 1000);
+    memset(big, 0xff, 1000);
+
+    for (u64 i = 0; i < 20; ++i) {
+        cr_assert(eq(u8, ptrs[i][39], (u8)i));
+    }
+
+    arena_free(&arena);
+}
+
+Test(TestArena, test_arena_reset_reuses_memory)
+{
+    Arena arena = arena_new(64);
+
+    u8* first = arena_alloc(&arena, 32);
+    arena_alloc(&arena, 48);
+    arena_reset(&arena);
+
+    cr_assert(eq(ptr, arena_alloc(&arena, 32), first));
+
+    arena_free(&arena);
+}
+
+Test(TestArena, test_arena_save_restore)
+{
+    Arena arena = arena_new(128);
+
+    arena_alloc(&arena, 16);
+    ArenaCheckpoint checkpoint = arena_save(&arena);
+    u8* before = arena_alloc(&arena, 16);
+
+    for (u64 i = 0; i < 10; ++i) {
+        arena_alloc(&arena, 100);
+    }
+    arena_restore(&arena, checkpoint);
+
+    cr_assert(eq(ptr, arena_alloc(&arena, 16), before));
+
+    arena_free(&arena);
+}
+
+Test(TestArena, test_arena_scratch)
+{
+    ArenaScratch outer = arena_scratch_begin(NULL, 0);
+    u8* result = arena_alloc(outer.arena, 8);
+
+    // Inner scratch must not clash with arena which holds result.
+    ArenaScratch inner = arena_scratch_begin(&outer.arena, 1);
+    cr_assert(ne(ptr, inner.arena, outer.arena));
+    u8* tmp = arena_alloc(inner.arena, 8);
+    arena_scratch_end(inner);
+
+    ArenaScratch again = arena_scratch_begin(&outer.arena, 1);
+    cr_assert(eq(ptr, arena_alloc(again.arena, 8), tmp));
+    arena_scratch_end(again);
+
+    cr_assert(not eq(ptr, result, NULL));
+    arena_scratch_end(outer);
+    arena_scratch_free();
+}
@@ -0,0 +1,130 @@
+#include <criterion/criterion.h>
+#include <criterion/new/assert.h>
+
+#include "nclib/streams/bit_stream.h"
+#include "nclib/streams/mut_bit_stream.h"
+
+// Fields 3, 5 and 12 bits wide: 0b101, 0b00111, 0xabc.
+u8 msb_payload[] = { 0xa7, 0xab, 0xc0 };
+u8 lsb_payload[] = { 0x3d, 0xbc, 0x0a };
+
+Test(TestBitStream, test_bit_stream_read_bits_msb)
+{
+    BitStream stream = bit_stream_new_msb(msb_payload, sizeof msb_payload);
+
+    cr_assert(eq(u64, bit_stream_read_bits(&stream, 3), 0x5));
+    cr_assert(eq(u64, bit_stream_read_bits(&stream, 5), 0x7));
+    cr_assert(eq(u64, bit_stream_read_bits(&stream, 12), 0xabc));
+    cr_assert(eq(u64, bit_stream_tell(&stream), 20));
+    cr_assert(eq(u64, bit_stream_size(&stream), 24));
+}
+
+Test(TestBitStream, test_bit_stream_read_bits_lsb)
+{
+    BitStream stream = bit_stream_new_lsb(lsb_payload, sizeof lsb_payload);
+
+    cr_assert(eq(u64, bit_stream_read_bits(&stream, 3), 0x5));
+    cr_assert(eq(u64, bit_stream_read_bits(&stream, 5), 0x7));
+    cr_assert(eq(u64, bit_stream_read_bits(&stream, 12), 0xabc));
+    cr_assert(eq(u64, bit_stream_tell(&stream), 20));
+}
+
+Test(TestBitStream, test_bit_stream_peek_bits)
+{
+    BitStream stream = bit_stream_new_msb(msb_payload, sizeof msb_payload);
+
+    cr_assert(eq(u64, bit_stream_peek_bits(&stream, 8), 0xa7));
+    cr_assert(eq(u64, bit_stream_tell(&stream), 0));
+    cr_assert(eq(u64, bit_stream_read_bits(&stream, 8), 0xa7));
+}
+
+Test(TestBitStream, test_bit_stream_read_bit)
+{
+    BitStream stream = bit_stream_new_msb(msb_payload, sizeof msb_payload);
+
+    cr_assert(bit_stream_read_bit(&stream));
+    cr_assert(not bit_stream_read_bit(&stream));
+    cr_assert(bit_stream_read_bit(&stream));
+}
+
+Test(TestBitStream, test_bit_stream_skip_and_align)
+{
+    u8 payload[20] = { 0 };
+    payload[17] = 0x5a;
+    BitStream stream = bit_stream_new_msb(payload, sizeof payload);
+
+    bit_stream_read_bits(&stream, 3);
+    bit_stream_align(&stream);
+    cr_assert(eq(u64, bit_stream_tell(&stream), 8));
+
+    bit_stream_skip_bits(&stream, 8 * 16 + 4);
+    cr_assert(eq(u64, bit_stream_read_bits(&stream, 4), 0xa));
+    cr_assert(eq(u64, bit_stream_tell(&stream), 144));
+}
+
+Test(TestBitStream, test_bit_stream_read_after_end)
+{
+    BitStream stream = bit_stream_new_lsb(lsb_payload, sizeof lsb_payload);
+
+    bit_stream_skip_bits(&stream, 20);
+    cr_assert(eq(u64, bit_stream_peek_bits(&stream, 56), 0));
+}
+
+Test(TestBitStream, test_bit_stream_round_trip)
+{
+    u8 buf[600];
+    BitStreamOrder orders[2] = { BIT_STREAM_MSB_FIRST, BIT_STREAM_LSB_FIRST };
+
+    for (u64 o = 0; o < 2; ++o) {
+        MutBitStream out = mut_bit_stream_new(buf, sizeof buf, orders[o]);
+        u64 seed = 3;
+        u64 total = 0;
+
+        for (u32 i = 0; i < 80; ++i) {
+            seed = seed * 6364136223846793005 + 1442695040888963407;
+            u32 count = i % (MUT_BIT_STREAM_MAX_WRITE_BITS + 1);
+            mut_bit_stream_write_bits(&out, seed, count);
+            total += count;
+        }
+        cr_assert(eq(u64, mut_bit_stream_tell(&out), total));
+        mut_bit_stream_flush(&out);
+        cr_assert(eq(u64, mut_bit_stream_tell(&out), (total + 7) / 8 * 8));
+
+        BitStream in = bit_stream_new(buf, (total + 7) / 8, orders[o]);
+        seed = 3;
+        for (u32 i = 0; i < 80; ++i) {
+            seed = seed * 6364136223846793005 + 1442695040888963407;
+            u32 count = i % (BIT_STREAM_MAX_READ_BITS + 1);
+            u64 mask = ((u64)1 << count) - 1;
+            cr_assert(eq(u64, bit_stream_read_bits(&in, count), seed & mask));
+        }
+    }
+}
+
+Test(TestMutBitStream, test_mut_bit_stream_write_bits_msb)
+{
+    u8 buf[3];
+    MutBitStream stream = mut_bit_stream_new_msb(buf, sizeof buf);
+
+    mut_bit_stream_write_bits(&stream, 0x5, 3);
+    mut_bit_stream_write_bits(&stream, 0x7, 5);
+    mut_bit_stream_write_bits(&stream, 0xabc, 12);
+    mut_bit_stream_flush(&stream);
+
+    cr_assert_arr_eq(buf, msb_payload, sizeof msb_payload);
+    cr_assert(eq(u64, mut_bit_stream_tell(&stream), 24));
+}
+
+Test(TestMutBitStream, test_mut_bit_stream_write_bits_lsb)
+{
+    u8 buf[3];
+    MutBitStream stream = mut_bit_stream_new_lsb(buf, sizeof buf);
+
+    mut_bit_stream_write_bits(&stream, 0x5, 3);
+    mut_bit_stream_write_bit(&stream, true);
+    mut_bit_stream_write_bits(&stream, 0x3, 4);
+    mut_bit_stream_write_bits(&stream, 0xfabc, 12);
+    mut_bit_stream_flush(&stream);
+
+    cr_assert_arr_eq(buf, lsb_payload, sizeof lsb_payload);
+}
@@ -0,0 +1,71 @@
+#include <criterion/criterion.h>
+#include <criterion/new/assert.h>
+
+#include "nclib/checksum/crc32c.h"
+
+// Bitwise reference implementation.
+static u32 crc32c_reference(u8 const* data, u64 size)
+{
+    u32 crc = 0xffffffff;
+
+    for (u64 i = 0; i < size; ++i) {
+        crc ^= data[i];
+        for (u64 bit = 0; bit < 8; ++bit) {
+            crc = (crc >> 1) ^ (0x82f63b78 & -(crc & 1));
+        }
+    }
+
+    return ~crc;
+}
+
+Test(TestCrc32c, test_crc32c_check_value)
+{
+    cr_assert(eq(u32, crc32c(0, "123456789", 9), 0xe3069283));
+    cr_assert(eq(u32, crc32c(0, "", 0), 0));
+}
+
+// Test vectors from RFC 3720 (iSCSI).
+Test(TestCrc32c, test_crc32c_rfc3720)
+{
+    u8 buf[32];
+
+    memset(buf, 0, sizeof buf);
+    cr_assert(eq(u32, crc32c(0, buf, sizeof buf), 0x8a9136aa));
+
+    memset(buf, 0xff, sizeof buf);
+    cr_assert(eq(u32, crc32c(0, buf, sizeof buf), 0x62a8ab43));
+
+    for (u64 i = 0; i < sizeof buf; ++i) {
+        buf[i] = (u8)i;
+    }
+    cr_assert(eq(u32, crc32c(0, buf, sizeof buf), 0x46dd794e));
+}
+
+Test(TestCrc32c, test_crc32c_matches_reference)
+{
+    u8 buf[1000];
+
+    for (u64 i = 0; i < sizeof buf; ++i) {
+        buf[i] = (u8)(i * 131 + 17);
+    }
+
+    // Every size and unaligned start to cover tails of word loops.
+    for (u64 size = 0; size < 70; ++size) {
+        cr_assert(eq(u32, crc32c(0, buf + 3, size),
+                     crc32c_reference(buf + 3, size)));
+    }
+    cr_assert(eq(u32, crc32c(0, buf, sizeof buf),
+                 crc32c_reference(buf, sizeof buf)));
+}
+
+Test(TestCrc32c, test_crc32c_continue)
+{
+    u8 const* data = (u8 const*)"The quick brown fox jumps over the lazy dog";
+    u64 size = strlen((char const*)data);
+
+    for (u64 split = 0; split <= size; ++split) {
+        u32 crc = crc32c(0, data, split);
+        crc = crc32c(crc, data + split, size - split);
+        cr_assert(eq(u32, crc, crc32c(0, data, size)));
+    }
+}
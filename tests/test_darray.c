@@ -0,0 +1,134 @@
+#include <criterion/criterion.h>
+#include <criterion/new/assert.h>
+
+#include "nclib/darray/darray.h"
+#include "nclib/streams/stream.h"
+
+DARRAY_DEFINE(U32Darray, u32)
+
+typedef struct {
+    i32 x;
+    i32 y;
+} Point;
+
+DARRAY_DEFINE(PointDarray, Point)
+
+u8 be_payload[] = { 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x02 };
+
+Test(TestDarray, test_darray_new)
+{
+    U32Darray array = U32Darray_new();
+
+    cr_assert(eq(u64, U32Darray_len(&array), 0));
+    cr_assert(eq(u64, U32Darray_capacity(&array), 0));
+    cr_assert(eq(ptr, U32Darray_data(&array), NULL));
+    U32Darray_free(&array);
+}
+
+Test(TestDarray, test_darray_push_get)
+{
+    U32Darray array = U32Darray_new();
+
+    for (u32 i = 0; i < 100; ++i) {
+        U32Darray_push(&array, i * 2);
+    }
+
+    cr_assert(eq(u64, U32Darray_len(&array), 100));
+    cr_assert(ge(u64, U32Darray_capacity(&array), 100));
+    for (u32 i = 0; i < 100; ++i) {
+        cr_assert(eq(u32, U32Darray_get(&array, i), i * 2));
+    }
+    U32Darray_free(&array);
+}
+
+Test(TestDarray, test_darray_geometric_growth)
+{
+    U32Darray array = U32Darray_new();
+    u64 reallocs = 0;
+    u64 capacity = 0;
+
+    for (u32 i = 0; i < 100000; ++i) {
+        U32Darray_push(&array, i);
+        if (U32Darray_capacity(&array) != capacity) {
+            capacity = U32Darray_capacity(&array);
+            ++reallocs;
+        }
+    }
+
+    cr_assert(le(u64, reallocs, 20));
+    U32Darray_free(&array);
+}
+
+Test(TestDarray, test_darray_reserve_shrink)
+{
+    U32Darray array = U32Darray_with_capacity(50);
+    cr_assert(ge(u64, U32Darray_capacity(&array), 50));
+
+    U32Darray_push(&array, 1);
+    U32Darray_push(&array, 2);
+    U32Darray_shrink_to_fit(&array);
+
+    cr_assert(eq(u64, U32Darray_capacity(&array), 2));
+    cr_assert(eq(u32, U32Darray_get(&array, 1), 2));
+    U32Darray_free(&array);
+}
+
+Test(TestDarray, test_darray_append_n)
+{
+    U32Darray array = U32Darray_new();
+    u32 items[5] = { 1, 2, 3, 4, 5 };
+
+    U32Darray_push(&array, 0);
+    U32Darray_append_n(&array, items, 5);
+
+    cr_assert(eq(u64, U32Darray_len(&array), 6));
+    cr_assert_arr_eq(U32Darray_data(&array) + 1, items, sizeof items);
+    U32Darray_free(&array);
+}
+
+Test(TestDarray, test_darray_extend_with_stream)
+{
+    U32Darray array = U32Darray_new();
+    Stream stream = stream_new_be(be_payload, sizeof be_payload);
+
+    stream_read_u32_array(&stream, U32Darray_extend(&array, 2), 2);
+
+    cr_assert(eq(u64, U32Darray_len(&array), 2));
+    cr_assert(eq(u32, U32Darray_get(&array, 0), 1));
+    cr_assert(eq(u32, U32Darray_get(&array, 1), 2));
+    U32Darray_free(&array);
+}
+
+Test(TestDarray, test_darray_pop_swap_remove)
+{
+    U32Darray array = U32Darray_new();
+    for (u32 i = 0; i < 5; ++i) {
+        U32Darray_push(&array, i);
+    }
+
+    cr_assert(eq(u32, U32Darray_pop(&array), 4));
+    cr_assert(eq(u32, U32Darray_swap_remove(&array, 1), 1));
+
+    cr_assert(eq(u64, U32Darray_len(&array), 3));
+    cr_assert(eq(u32, U32Darray_get(&array, 0), 0));
+    cr_assert(eq(u32, U32Darray_get(&array, 1), 3));
+    cr_assert(eq(u32, U32Darray_get(&array, 2), 2));
+    U32Darray_free(&array);
+}
+
+Test(TestDarray, test_darray_struct_items)
+{
+    PointDarray array = PointDarray_new();
+
+    PointDarray_push(&array, (Point) { .x = 1, .y = 2 });
+    PointDarray_at(&array, 0)->y = 5;
+    Point point = PointDarray_get(&array, 0);
+    PointDarray_set(&array, 0, (Point) { .x = point.x, .y = point.y + 1 });
+
+    cr_assert(eq(i32, PointDarray_get(&array, 0).x, 1));
+    cr_assert(eq(i32, PointDarray_get(&array, 0).y, 6));
+
+    PointDarray_clear(&array);
+    cr_assert(eq(u64, PointDarray_len(&array), 0));
+    PointDarray_free(&array);
+}
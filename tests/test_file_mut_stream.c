@@ -0,0 +1,175 @@
+// mkstemp is hidden by strict c2x mode.
+#define _DEFAULT_SOURCE
+
+#include <float.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <criterion/criterion.h>
+#include <criterion/new/assert.h>
+
+#include "nclib/streams/file_mut_stream.h"
+
+/* be and le payload layout:
+ | 1 byte | 2 bytes   | 4 bytes | 8 bytes | ....
+ |    u8  |   u16     |   u32   |   u64   | ....
+  .... | 1 byte | 2 bytes | 4 bytes | 8 bytes | 4 bytes | 8 bytes | ....
+  .... |   i8   |   i16   |   i32   |   i64   |    f32  |   f64   | ....
+  .... | 1 byte | 1 byte  |
+  .... |   bool |   bool  |
+*/
+
+u8 be_payload[] = {
+    0x9c, 0xff, 0x9c, 0xff, 0xff, 0xff, 0x9c, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0x9c, 0xe4, 0x80, 0x64, 0x80, 0x00, 0x00, 0x64,
+    0x80, 0x0,  0x0,  0x0,  0x0,  0x0,  0x0,  0x64, 0x7f, 0x7f, 0xff,
+    0xff, 0x7f, 0xef, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x0,  0x1,
+};
+u8 le_payload[] = {
+    0x9c, 0x9c, 0xff, 0x9c, 0xff, 0xff, 0xff, 0x9c, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xe4, 0x64, 0x80, 0x64, 0x0,  0x0,  0x80,
+    0x64, 0x0,  0x0,  0x0,  0x0,  0x0,  0x0,  0x80, 0xff, 0xff, 0x7f,
+    0x7f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0x7f, 0x0,  0x1,
+};
+
+const u8 u8_expected = 156; // 2^8  - 100
+const u16 u16_expected = 65436; // 2^16 - 100
+const u32 u32_expected = 4294967196; // 2^32 - 100
+const u64 u64_expected = 18446744073709551516u; // 2^64 - 100
+
+const i8 i8_expected = -28; // -(2^8  / 2 - 100)
+const i16 i16_expected = -32668; // -(2^16 / 2 - 100)
+const i32 i32_expected = -2147483548; // -(2^32 / 2 - 100)
+const i64 i64_expected = -9223372036854775708; // -(2^64 / 2 - 100)
+
+const f32 f32_expected = FLT_MAX;
+const f64 f64_expected = DBL_MAX;
+
+const bool bool1_expected = false;
+const bool bool2_expected = true;
+
+static int open_tmp_file(void)
+{
+    char path[] = "/tmp/nclib_file_mut_stream_XXXXXX";
+    int fd = mkstemp(path);
+    cr_assert(ge(i32, fd, 0));
+    unlink(path);
+
+    return fd;
+}
+
+static void read_file(int fd, u8* buf, u64 size)
+{
+    lseek(fd, 0, SEEK_SET);
+    cr_assert(eq(i64, read(fd, buf, size), (i64)size));
+}
+
+static void write_all_types(FileMutStream* s)
+{
+    file_mut_stream_write_u8(s, u8_expected);
+    file_mut_stream_write_u16(s, u16_expected);
+    file_mut_stream_write_u32(s, u32_expected);
+    file_mut_stream_write_u64(s, u64_expected);
+    file_mut_stream_write_i8(s, i8_expected);
+    file_mut_stream_write_i16(s, i16_expected);
+    file_mut_stream_write_i32(s, i32_expected);
+    file_mut_stream_write_i64(s, i64_expected);
+    file_mut_stream_write_f32(s, f32_expected);
+    file_mut_stream_write_f64(s, f64_expected);
+    file_mut_stream_write_bool(s, bool1_expected);
+    file_mut_stream_write_bool(s, bool2_expected);
+}
+
+Test(TestFileMutStream, test_write_be)
+{
+    int fd = open_tmp_file();
+
+    // Small buffer makes most writes cross its edge.
+    FileMutStream s = file_mut_stream_new_be(fd, 7);
+    for (u64 i = 0; i < 10; ++i) {
+        write_all_types(&s);
+    }
+    cr_assert(eq(u64, file_mut_stream_tell(&s), 10 * sizeof be_payload));
+    file_mut_stream_free(&s);
+
+    u8 buf[10 * sizeof be_payload];
+    read_file(fd, buf, sizeof buf);
+    for (u64 i = 0; i < 10; ++i) {
+        cr_assert_arr_eq(buf + i * sizeof be_payload, be_payload,
+                         sizeof be_payload);
+    }
+    close(fd);
+}
+
+Test(TestFileMutStream, test_write_le)
+{
+    int fd = open_tmp_file();
+
+    FileMutStream s = file_mut_stream_new_le(fd, 0);
+    write_all_types(&s);
+    file_mut_stream_flush(&s);
+
+    u8 buf[sizeof le_payload];
+    read_file(fd, buf, sizeof buf);
+    cr_assert_arr_eq(buf, le_payload, sizeof le_payload);
+
+    file_mut_stream_free(&s);
+    close(fd);
+}
+
+Test(TestFileMutStream, test_write_big_payload)
+{
+    int fd = open_tmp_file();
+
+    FileMutStream s = file_mut_stream_new_be(fd, 16);
+    file_mut_stream_write_u8(&s, u8_expected);
+    file_mut_stream_write_bytes(&s, be_payload + 1, sizeof be_payload - 1);
+    file_mut_stream_write_bytes(&s, be_payload, 10);
+    file_mut_stream_write_bytes(&s, be_payload + 10, sizeof be_payload - 10);
+    file_mut_stream_free(&s);
+
+    u8 buf[2 * sizeof be_payload];
+    read_file(fd, buf, sizeof buf);
+    cr_assert_arr_eq(buf, be_payload, sizeof be_payload);
+    cr_assert_arr_eq(buf + sizeof be_payload, be_payload, sizeof be_payload);
+    close(fd);
+}
+
+Test(TestFileMutStream, test_write_array)
+{
+    int fd = open_tmp_file();
+
+    u32 nums[100];
+    for (u32 i = 0; i < 100; ++i) {
+        nums[i] = 0x01020304u * i;
+    }
+
+    FileMutStream s = file_mut_stream_new(fd, 30, STREAM_BIG_ENDIAN);
+    file_mut_stream_write_u32_array(&s, nums, 100);
+    file_mut_stream_free(&s);
+
+    u32 res[100];
+    read_file(fd, (u8*)res, sizeof res);
+    for (u32 i = 0; i < 100; ++i) {
+        cr_assert(eq(u32, res[i], __builtin_bswap32(nums[i])));
+    }
+    close(fd);
+}
+
+Test(TestFileMutStream, test_write_array_tiny_buffer)
+{
+    int fd = open_tmp_file();
+
+    u64 nums[] = { u64_expected, 0x0102030405060708u };
+
+    // Buffer is smaller than one item.
+    FileMutStream s = file_mut_stream_new_be(fd, 4);
+    file_mut_stream_write_u64_array(&s, nums, 2);
+    file_mut_stream_free(&s);
+
+    u64 res[2];
+    read_file(fd, (u8*)res, sizeof res);
+    cr_assert(eq(u64, res[0], __builtin_bswap64(nums[0])));
+    cr_assert(eq(u64, res[1], __builtin_bswap64(nums[1])));
+    close(fd);
+}
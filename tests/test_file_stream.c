@@ -0,0 +1,199 @@
+// mkstemp is hidden by strict c2x mode.
+#define _DEFAULT_SOURCE
+
+#include <float.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <criterion/criterion.h>
+#include <criterion/new/assert.h>
+
+#include "nclib/streams/file_stream.h"
+
+/* be and le payload layout:
+ | 1 byte | 2 bytes   | 4 bytes | 8 bytes | ....
+ |    u8  |   u16     |   u32   |   u64   | ....
+  .... | 1 byte | 2 bytes | 4 bytes | 8 bytes | 4 bytes | 8 bytes | ....
+  .... |   i8   |   i16   |   i32   |   i64   |    f32  |   f64   | ....
+  .... | 1 byte | 1 byte  |
+  .... |   bool |   bool  |
+*/
+
+u8 be_payload[] = {
+    0x9c, 0xff, 0x9c, 0xff, 0xff, 0xff, 0x9c, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0x9c, 0xe4, 0x80, 0x64, 0x80, 0x00, 0x00, 0x64,
+    0x80, 0x0,  0x0,  0x0,  0x0,  0x0,  0x0,  0x64, 0x7f, 0x7f, 0xff,
+    0xff, 0x7f, 0xef, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x0,  0x1,
+};
+u8 le_payload[] = {
+    0x9c, 0x9c, 0xff, 0x9c, 0xff, 0xff, 0xff, 0x9c, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xe4, 0x64, 0x80, 0x64, 0x0,  0x0,  0x80,
+    0x64, 0x0,  0x0,  0x0,  0x0,  0x0,  0x0,  0x80, 0xff, 0xff, 0x7f,
+    0x7f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0x7f, 0x0,  0x1,
+};
+
+const u8 u8_expected = 156; // 2^8  - 100
+const u16 u16_expected = 65436; // 2^16 - 100
+const u32 u32_expected = 4294967196; // 2^32 - 100
+const u64 u64_expected = 18446744073709551516u; // 2^64 - 100
+
+const i8 i8_expected = -28; // -(2^8  / 2 - 100)
+const i16 i16_expected = -32668; // -(2^16 / 2 - 100)
+const i32 i32_expected = -2147483548; // -(2^32 / 2 - 100)
+const i64 i64_expected = -9223372036854775708; // -(2^64 / 2 - 100)
+
+const f32 f32_expected = FLT_MAX;
+const f64 f64_expected = DBL_MAX;
+
+const bool bool1_expected = false;
+const bool bool2_expected = true;
+
+static int open_payload(u8 const* payload, u64 size, u64 repeat)
+{
+    char path[] = "/tmp/nclib_file_stream_XXXXXX";
+    int fd = mkstemp(path);
+    cr_assert(ge(i32, fd, 0));
+    unlink(path);
+
+    for (u64 i = 0; i < repeat; ++i) {
+        cr_assert(eq(i64, write(fd, payload, size), (i64)size));
+    }
+    lseek(fd, 0, SEEK_SET);
+
+    return fd;
+}
+
+static void read_all_types(FileStream* s)
+{
+    cr_assert(eq(u8, file_stream_read_u8(s), u8_expected));
+    cr_assert(eq(u16, file_stream_read_u16(s), u16_expected));
+    cr_assert(eq(u32, file_stream_read_u32(s), u32_expected));
+    cr_assert(eq(u64, file_stream_read_u64(s), u64_expected));
+    cr_assert(eq(i8, file_stream_read_i8(s), i8_expected));
+    cr_assert(eq(i16, file_stream_read_i16(s), i16_expected));
+    cr_assert(eq(i32, file_stream_read_i32(s), i32_expected));
+    cr_assert(eq(i64, file_stream_read_i64(s), i64_expected));
+    cr_assert(eq(flt, file_stream_read_f32(s), f32_expected));
+    cr_assert(eq(dbl, file_stream_read_f64(s), f64_expected));
+    cr_assert(file_stream_read_bool(s) == bool1_expected);
+    cr_assert(file_stream_read_bool(s) == bool2_expected);
+}
+
+Test(TestFileStream, test_read_be_across_window)
+{
+    int fd = open_payload(be_payload, sizeof be_payload, 10);
+
+    // Small window makes most reads cross its edge.
+    FileStream s = file_stream_new_be(fd, 7);
+    cr_assert(eq(u64, file_stream_size(&s), 10 * sizeof be_payload));
+
+    for (u64 i = 0; i < 10; ++i) {
+        read_all_types(&s);
+        cr_assert(eq(u64, file_stream_tell(&s), (i + 1) * sizeof be_payload));
+    }
+
+    file_stream_free(&s);
+    close(fd);
+}
+
+Test(TestFileStream, test_read_le)
+{
+    int fd = open_payload(le_payload, sizeof le_payload, 3);
+
+    FileStream s = file_stream_new_le(fd, 0);
+    for (u64 i = 0; i < 3; ++i) {
+        read_all_types(&s);
+    }
+
+    file_stream_free(&s);
+    close(fd);
+}
+
+Test(TestFileStream, test_read_bytes_bigger_than_window)
+{
+    int fd = open_payload(be_payload, sizeof be_payload, 2);
+
+    FileStream s = file_stream_new_be(fd, 8);
+    cr_assert(eq(u8, file_stream_read_u8(&s), u8_expected));
+
+    u8 buf[sizeof be_payload];
+    file_stream_read_bytes(&s, buf, sizeof buf);
+    cr_assert_arr_eq(buf, be_payload + 1, sizeof be_payload - 1);
+    cr_assert(eq(u8, buf[sizeof buf - 1], be_payload[0]));
+    cr_assert(eq(u16, file_stream_read_u16(&s), u16_expected));
+
+    file_stream_free(&s);
+    close(fd);
+}
+
+Test(TestFileStream, test_read_array)
+{
+    u32 nums[100];
+    for (u32 i = 0; i < 100; ++i) {
+        nums[i] = 0x01020304u * i;
+    }
+    int fd = open_payload((u8*)nums, sizeof nums, 1);
+
+    FileStream s = file_stream_new(fd, 64, STREAM_LITTLE_ENDIAN);
+    u32 res[100];
+    file_stream_read_u32_array(&s, res, 100);
+    cr_assert_arr_eq(res, nums, sizeof nums);
+    file_stream_free(&s);
+
+    lseek(fd, 0, SEEK_SET);
+    s = file_stream_new(fd, 64, STREAM_BIG_ENDIAN);
+    file_stream_read_u32_array(&s, res, 100);
+    for (u32 i = 0; i < 100; ++i) {
+        cr_assert(eq(u32, res[i], __builtin_bswap32(nums[i])));
+    }
+
+    file_stream_free(&s);
+    close(fd);
+}
+
+Test(TestFileStream, test_file_stream_seek)
+{
+    int fd = open_payload(be_payload, sizeof be_payload, 4);
+
+    FileStream s = file_stream_new_be(fd, 16);
+    file_stream_read_u8(&s);
+
+    // Inside window.
+    file_stream_seek(&s, 1, STREAM_START);
+    cr_assert(eq(u16, file_stream_read_u16(&s), u16_expected));
+
+    // Outside window.
+    file_stream_seek(&s, 2 * sizeof be_payload + 3, STREAM_START);
+    cr_assert(eq(u32, file_stream_read_u32(&s), u32_expected));
+
+    file_stream_seek(&s, -(i64)(sizeof be_payload + 7), STREAM_CURR);
+    cr_assert(eq(u64, file_stream_tell(&s), sizeof be_payload));
+    read_all_types(&s);
+
+    file_stream_seek(&s, 2, STREAM_END);
+    cr_assert(file_stream_read_bool(&s) == bool1_expected);
+    cr_assert(file_stream_read_bool(&s) == bool2_expected);
+    cr_assert(eq(u64, file_stream_tell(&s), file_stream_size(&s)));
+
+    file_stream_free(&s);
+    close(fd);
+}
+
+Test(TestFileStream, test_offsets_are_absolute)
+{
+    int fd = open_payload(be_payload, sizeof be_payload, 1);
+
+    // u16 of payload starts at byte 1.
+    lseek(fd, 1, SEEK_SET);
+
+    FileStream s = file_stream_new_be(fd, 16);
+    cr_assert(eq(u64, file_stream_tell(&s), 1));
+    cr_assert(eq(u64, file_stream_size(&s), sizeof be_payload));
+    cr_assert(eq(u16, file_stream_read_u16(&s), u16_expected));
+
+    file_stream_seek(&s, 0, STREAM_START);
+    cr_assert(eq(u8, file_stream_read_u8(&s), u8_expected));
+
+    file_stream_free(&s);
+    close(fd);
+}
@@ -0,0 +1,204 @@
+#include <string.h>
+
+#include <criterion/criterion.h>
+#include <criterion/new/assert.h>
+
+#include "nclib/hash_table/hash_table.h"
+#include "nclib/str/str_view.h"
+
+static HashTable new_u64_table(void)
+{
+    return hash_table_new(sizeof(u64), sizeof(u32), hash_table_hash_u64,
+                          hash_table_eq_u64);
+}
+
+Test(TestHashTable, test_hash_table_new)
+{
+    HashTable table = new_u64_table();
+    u64 key = 1;
+
+    cr_assert(eq(u64, hash_table_size(&table), 0));
+    cr_assert(eq(u64, hash_table_capacity(&table), 0));
+    cr_assert(eq(ptr, hash_table_get(&table, &key), NULL));
+    cr_assert(not hash_table_remove(&table, &key));
+    hash_table_free(&table);
+}
+
+Test(TestHashTable, test_hash_table_insert_get)
+{
+    HashTable table = new_u64_table();
+    u64 key = 42;
+    u32 value = 100;
+
+    hash_table_insert(&table, &key, &value);
+
+    u32* found = hash_table_get(&table, &key);
+    cr_assert(not eq(ptr, found, NULL));
+    cr_assert(eq(u32, *found, 100));
+    cr_assert(eq(u64, hash_table_size(&table), 1));
+
+    // Insert of existing key replaces value.
+    value = 200;
+    hash_table_insert(&table, &key, &value);
+    cr_assert(eq(u32, *(u32*)hash_table_get(&table, &key), 200));
+    cr_assert(eq(u64, hash_table_size(&table), 1));
+
+    hash_table_free(&table);
+}
+
+Test(TestHashTable, test_hash_table_many)
+{
+    HashTable table = new_u64_table();
+
+    for (u64 key = 0; key < 10000; ++key) {
+        u32 value = (u32)(key * 3);
+        hash_table_insert(&table, &key, &value);
+    }
+
+    cr_assert(eq(u64, hash_table_size(&table), 10000));
+    for (u64 key = 0; key < 10000; ++key) {
+        u32* value = hash_table_get(&table, &key);
+        cr_assert(not eq(ptr, value, NULL));
+        cr_assert(eq(u32, *value, (u32)(key * 3)));
+    }
+    u64 missing = 10000;
+    cr_assert(not hash_table_contains(&table, &missing));
+
+    hash_table_free(&table);
+}
+
+Test(TestHashTable, test_hash_table_remove)
+{
+    HashTable table = new_u64_table();
+
+    for (u64 key = 0; key < 1000; ++key) {
+        u32 value = (u32)key;
+        hash_table_insert(&table, &key, &value);
+    }
+    for (u64 key = 0; key < 1000; key += 2) {
+        cr_assert(hash_table_remove(&table, &key));
+    }
+
+    cr_assert(eq(u64, hash_table_size(&table), 500));
+    for (u64 key = 0; key < 1000; ++key) {
+        cr_assert(eq(u8, hash_table_contains(&table, &key), key % 2 == 1));
+    }
+
+    hash_table_free(&table);
+}
+
+Test(TestHashTable, test_hash_table_churn_keeps_capacity)
+{
+    HashTable table = new_u64_table();
+    hash_table_reserve(&table, 100);
+    u64 capacity = hash_table_capacity(&table);
+
+    // Tombstones must not make table grow forever.
+    for (u64 key = 0; key < 100000; ++key) {
+        u32 value = 0;
+        hash_table_insert(&table, &key, &value);
+        if (key >= 50) {
+            u64 old = key - 50;
+            cr_assert(hash_table_remove(&table, &old));
+        }
+    }
+
+    cr_assert(eq(u64, hash_table_size(&table), 50));
+    cr_assert(eq(u64, hash_table_capacity(&table), capacity));
+    hash_table_free(&table);
+}
+
+Test(TestHashTable, test_hash_table_reserve)
+{
+    HashTable table = new_u64_table();
+
+    hash_table_reserve(&table, 1000);
+    u64 capacity = hash_table_capacity(&table);
+    cr_assert(ge(u64, capacity, 1000));
+
+    for (u64 key = 0; key < 1000; ++key) {
+        u32 value = 0;
+        hash_table_insert(&table, &key, &value);
+    }
+    cr_assert(eq(u64, hash_table_capacity(&table), capacity));
+
+    hash_table_free(&table);
+}
+
+Test(TestHashTable, test_hash_table_clear)
+{
+    HashTable table = new_u64_table();
+    u64 key = 7;
+    u32 value = 1;
+
+    hash_table_insert(&table, &key, &value);
+    hash_table_clear(&table);
+
+    cr_assert(eq(u64, hash_table_size(&table), 0));
+    cr_assert(not hash_table_contains(&table, &key));
+    hash_table_free(&table);
+}
+
+Test(TestHashTable, test_hash_table_next)
+{
+    HashTable table = new_u64_table();
+
+    for (u64 key = 1; key <= 100; ++key) {
+        u32 value = (u32)key;
+        hash_table_insert(&table, &key, &value);
+    }
+
+    u64 index = 0;
+    void* key;
+    void* value;
+    u64 sum = 0;
+    u64 count = 0;
+    while (hash_table_next(&table, &index, &key, &value)) {
+        cr_assert(eq(u64, *(u64*)key, *(u32*)value));
+        sum += *(u64*)key;
+        ++count;
+    }
+
+    cr_assert(eq(u64, count, 100));
+    cr_assert(eq(u64, sum, 5050));
+    hash_table_free(&table);
+}
+
+Test(TestHashTable, test_hash_table_str_view_keys)
+{
+    HashTable table = hash_table_new(sizeof(StrView), sizeof(u32),
+                                     hash_table_hash_str_view,
+                                     hash_table_eq_str_view);
+    char const* words[] = { "apple", "banana", "cherry", "a longer key here" };
+
+    for (u32 i = 0; i < 4; ++i) {
+        StrView key = str_view_from_cstr(words[i]);
+        hash_table_insert(&table, &key, &i);
+    }
+
+    // Key with the same chars in other memory is found.
+    char buf[] = "banana";
+    StrView key = str_view_from_cstr(buf);
+    cr_assert(eq(u32, *(u32*)hash_table_get(&table, &key), 1));
+
+    hash_table_free(&table);
+}
+
+Test(TestHashTable, test_hash_table_in_arena)
+{
+    Arena arena = arena_new(0);
+    HashTable table = hash_table_new_in_arena(
+        sizeof(u32), sizeof(u64), hash_table_hash_u32, hash_table_eq_u32,
+        &arena);
+
+    for (u32 key = 0; key < 1000; ++key) {
+        u64 value = (u64)key << 32;
+        hash_table_insert(&table, &key, &value);
+    }
+    for (u32 key = 0; key < 1000; ++key) {
+        u64* value = hash_table_get(&table, &key);
+        cr_assert(eq(u64, *value, (u64)key << 32));
+    }
+
+    arena_free(&arena);
+}
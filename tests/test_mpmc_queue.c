@@ -0,0 +1,138 @@
+#include <pthread.h>
+#include <stdlib.h>
+
+#include <criterion/criterion.h>
+#include <criterion/new/assert.h>
+
+#include "nclib/queue/mpmc_queue.h"
+
+#define THREADS_COUNT 4
+#define THREAD_ITEMS 20000
+
+typedef struct {
+    u32 producer;
+    u32 index;
+} Item;
+
+Test(TestMpmcQueue, test_mpmc_queue_push_pop)
+{
+    MpmcQueue queue = mpmc_queue_new(4, sizeof(u64));
+    u64 num;
+
+    cr_assert(eq(u64, mpmc_queue_capacity(&queue), 4));
+    cr_assert(not mpmc_queue_try_pop(&queue, &num));
+
+    for (u64 i = 0; i < 4; ++i) {
+        cr_assert(mpmc_queue_try_push(&queue, &i));
+    }
+    num = 100;
+    cr_assert(not mpmc_queue_try_push(&queue, &num));
+
+    // Items go out in order and cells are reused on next lap.
+    for (u64 lap = 0; lap < 3; ++lap) {
+        for (u64 i = 0; i < 4; ++i) {
+            cr_assert(mpmc_queue_try_pop(&queue, &num));
+            cr_assert(eq(u64, num, lap * 4 + i));
+            num += 4;
+            cr_assert(mpmc_queue_try_push(&queue, &num));
+        }
+    }
+
+    mpmc_queue_free(&queue);
+}
+
+Test(TestMpmcQueue, test_mpmc_queue_batch)
+{
+    MpmcQueue queue = mpmc_queue_new(8, sizeof(Item));
+    Item items[10];
+    for (u32 i = 0; i < 10; ++i) {
+        items[i] = (Item) { .producer = 1, .index = i };
+    }
+
+    cr_assert(eq(u64, mpmc_queue_try_push_batch(&queue, items, 10), 8));
+    cr_assert(eq(u64, mpmc_queue_try_push_batch(&queue, items, 10), 0));
+
+    Item out[10];
+    cr_assert(eq(u64, mpmc_queue_try_pop_batch(&queue, out, 3), 3));
+    cr_assert(eq(u64, mpmc_queue_try_push_batch(&queue, items + 8, 2), 2));
+    cr_assert(eq(u64, mpmc_queue_try_pop_batch(&queue, out + 3, 10), 7));
+    for (u32 i = 0; i < 10; ++i) {
+        cr_assert(eq(u32, out[i].index, i));
+    }
+
+    mpmc_queue_free(&queue);
+}
+
+static void* produce(void* arg)
+{
+    MpmcQueue* queue = arg;
+    static _Atomic(u32) next_producer = 0;
+    u32 producer = atomic_fetch_add(&next_producer, 1) % THREADS_COUNT;
+
+    for (u32 i = 0; i < THREAD_ITEMS; i += 4) {
+        Item items[4];
+        for (u32 k = 0; k < 4; ++k) {
+            items[k] = (Item) { .producer = producer, .index = i + k };
+        }
+        if (i % 8 == 0) {
+            mpmc_queue_push_batch(queue, items, 4);
+            continue;
+        }
+        for (u32 k = 0; k < 4; ++k) {
+            mpmc_queue_push(queue, &items[k]);
+        }
+    }
+
+    return NULL;
+}
+
+static void* consume(void* arg)
+{
+    MpmcQueue* queue = arg;
+    u64* sums = calloc(THREADS_COUNT, sizeof *sums);
+
+    for (u64 popped = 0; popped < THREAD_ITEMS;) {
+        Item items[3];
+        u64 count = THREAD_ITEMS - popped < 3 ? THREAD_ITEMS - popped : 3;
+        count = mpmc_queue_pop_batch(queue, items, count);
+        for (u64 k = 0; k < count; ++k) {
+            sums[items[k].producer] += items[k].index;
+        }
+        popped += count;
+    }
+
+    return sums;
+}
+
+Test(TestMpmcQueue, test_mpmc_queue_threads)
+{
+    MpmcQueue queue = mpmc_queue_new_blocking(64, sizeof(Item));
+    pthread_t producers[THREADS_COUNT];
+    pthread_t consumers[THREADS_COUNT];
+
+    for (u64 i = 0; i < THREADS_COUNT; ++i) {
+        pthread_create(&producers[i], NULL, produce, &queue);
+        pthread_create(&consumers[i], NULL, consume, &queue);
+    }
+
+    u64 sums[THREADS_COUNT] = { 0 };
+    for (u64 i = 0; i < THREADS_COUNT; ++i) {
+        void* consumer_sums;
+        pthread_join(producers[i], NULL);
+        pthread_join(consumers[i], &consumer_sums);
+        for (u64 k = 0; k < THREADS_COUNT; ++k) {
+            sums[k] += ((u64*)consumer_sums)[k];
+        }
+        free(consumer_sums);
+    }
+
+    // Every item of every producer was popped once.
+    for (u64 k = 0; k < THREADS_COUNT; ++k) {
+        cr_assert(eq(u64, sums[k],
+                     (u64)THREAD_ITEMS * (THREAD_ITEMS - 1) / 2));
+    }
+    Item item;
+    cr_assert(not mpmc_queue_try_pop(&queue, &item));
+
+    mpmc_queue_free(&queue);
+}
@@ -1,4 +1,5 @@
 #include <float.h>
+#include <stdlib.h>
 
 #include <criterion/criterion.h>
 #include <criterion/new/assert.h>
@@ -636,6 +637,245 @@ Test(TestMutStream, test_mut_stream_write_void)
     cr_assert_arr_eq(void_payload, mut_stream_raw(&s), sizeof void_payload);
 }
 
+Test(TestMutStream, test_read_i16_be_inline)
+{
+    u8* payload_start = be_payload + i16_offset;
+    const u64 payload_size = sizeof be_payload - i16_offset;
+
+    MutStream s = mut_stream_new(payload_start, payload_size,
+                                 STREAM_BIG_ENDIAN);
+    i16 res = mut_stream_read_i16_be(&s);
+    cr_assert(eq(i16, res, i16_expected));
+}
+
+Test(TestMutStream, test_read_i16_le_inline)
+{
+    u8* payload_start = le_payload + i16_offset;
+    const u64 payload_size = sizeof le_payload - i16_offset;
+
+    MutStream s = mut_stream_new(payload_start, payload_size,
+                                 STREAM_BIG_ENDIAN);
+    i16 res = mut_stream_read_i16_le(&s);
+    cr_assert(eq(i16, res, i16_expected));
+}
+
+Test(TestMutStream, test_read_u32_be_inline)
+{
+    u8* payload_start = be_payload + u32_offset;
+    const u64 payload_size = sizeof be_payload - u32_offset;
+
+    MutStream s = mut_stream_new(payload_start, payload_size,
+                                 STREAM_BIG_ENDIAN);
+    u32 res = mut_stream_read_u32_be(&s);
+    cr_assert(eq(u32, res, u32_expected));
+}
+
+Test(TestMutStream, test_read_u32_le_inline)
+{
+    u8* payload_start = le_payload + u32_offset;
+    const u64 payload_size = sizeof le_payload - u32_offset;
+
+    MutStream s = mut_stream_new(payload_start, payload_size,
+                                 STREAM_BIG_ENDIAN);
+    u32 res = mut_stream_read_u32_le(&s);
+    cr_assert(eq(u32, res, u32_expected));
+}
+
+Test(TestMutStream, test_mut_stream_write_u16_be_inline)
+{
+    u8 buf[100];
+    MutStream s = mut_stream_new(buf, sizeof buf, STREAM_BIG_ENDIAN);
+
+    mut_stream_write_u16_be(&s, u16_expected);
+    cr_assert_arr_eq(be_payload + u16_offset, mut_stream_raw(&s),
+                     sizeof u16_expected);
+    cr_assert(eq(u64, mut_stream_tell(&s), sizeof u16_expected));
+}
+
+Test(TestMutStream, test_mut_stream_write_u16_le_inline)
+{
+    u8 buf[100];
+    MutStream s = mut_stream_new(buf, sizeof buf, STREAM_BIG_ENDIAN);
+
+    mut_stream_write_u16_le(&s, u16_expected);
+    cr_assert_arr_eq(le_payload + u16_offset, mut_stream_raw(&s),
+                     sizeof u16_expected);
+    cr_assert(eq(u64, mut_stream_tell(&s), sizeof u16_expected));
+}
+
+Test(TestMutStream, test_mut_stream_write_i32_be_inline)
+{
+    u8 buf[100];
+    MutStream s = mut_stream_new(buf, sizeof buf, STREAM_BIG_ENDIAN);
+
+    mut_stream_write_i32_be(&s, i32_expected);
+    cr_assert_arr_eq(be_payload + i32_offset, mut_stream_raw(&s),
+                     sizeof i32_expected);
+    cr_assert(eq(u64, mut_stream_tell(&s), sizeof i32_expected));
+}
+
+Test(TestMutStream, test_mut_stream_write_i32_le_inline)
+{
+    u8 buf[100];
+    MutStream s = mut_stream_new(buf, sizeof buf, STREAM_BIG_ENDIAN);
+
+    mut_stream_write_i32_le(&s, i32_expected);
+    cr_assert_arr_eq(le_payload + i32_offset, mut_stream_raw(&s),
+                     sizeof i32_expected);
+    cr_assert(eq(u64, mut_stream_tell(&s), sizeof i32_expected));
+}
+
+Test(TestMutStream, test_mut_stream_write_i64_be_inline)
+{
+    u8 buf[100];
+    MutStream s = mut_stream_new(buf, sizeof buf, STREAM_BIG_ENDIAN);
+
+    mut_stream_write_i64_be(&s, i64_expected);
+    cr_assert_arr_eq(be_payload + i64_offset, mut_stream_raw(&s),
+                     sizeof i64_expected);
+    cr_assert(eq(u64, mut_stream_tell(&s), sizeof i64_expected));
+}
+
+Test(TestMutStream, test_mut_stream_write_i64_le_inline)
+{
+    u8 buf[100];
+    MutStream s = mut_stream_new(buf, sizeof buf, STREAM_BIG_ENDIAN);
+
+    mut_stream_write_i64_le(&s, i64_expected);
+    cr_assert_arr_eq(le_payload + i64_offset, mut_stream_raw(&s),
+                     sizeof i64_expected);
+    cr_assert(eq(u64, mut_stream_tell(&s), sizeof i64_expected));
+}
+
+Test(TestMutStream, test_mut_stream_write_f32_be_inline)
+{
+    u8 buf[100];
+    MutStream s = mut_stream_new(buf, sizeof buf, STREAM_BIG_ENDIAN);
+
+    mut_stream_write_f32_be(&s, f32_expected);
+    cr_assert_arr_eq(be_payload + f32_offset, mut_stream_raw(&s),
+                     sizeof f32_expected);
+    cr_assert(eq(u64, mut_stream_tell(&s), sizeof f32_expected));
+}
+
+Test(TestMutStream, test_mut_stream_write_f32_le_inline)
+{
+    u8 buf[100];
+    MutStream s = mut_stream_new(buf, sizeof buf, STREAM_BIG_ENDIAN);
+
+    mut_stream_write_f32_le(&s, f32_expected);
+    cr_assert_arr_eq(le_payload + f32_offset, mut_stream_raw(&s),
+                     sizeof f32_expected);
+    cr_assert(eq(u64, mut_stream_tell(&s), sizeof f32_expected));
+}
+
+Test(TestMutStream, test_mut_stream_write_be_u64_array)
+{
+    u64 nums[19];
+    for (u64 i = 0; i < 19; ++i) {
+        nums[i] = 0x0102030405060708u * (i + 1);
+    }
+
+    u8 buf[sizeof nums];
+    MutStream s = mut_stream_new(buf, sizeof buf, STREAM_BIG_ENDIAN);
+    mut_stream_write_u64_array(&s, nums, 19);
+    cr_assert(eq(u64, mut_stream_tell(&s), sizeof buf));
+
+    for (u64 i = 0; i < 19; ++i) {
+        for (u64 j = 0; j < 8; ++j) {
+            cr_assert(eq(u8, buf[i * 8 + j], (u8)(nums[i] >> (56 - j * 8))));
+        }
+    }
+
+    u64 res[19];
+    mut_stream_seek(&s, 0, STREAM_START);
+    mut_stream_read_u64_array(&s, res, 19);
+    cr_assert_arr_eq(res, nums, sizeof nums);
+}
+
+Test(TestMutStream, test_mut_stream_write_le_i32_array)
+{
+    i32 nums[9] = { -1, 2, -3, 4, -5, 6, -7, 8, i32_expected };
+
+    u8 buf[sizeof nums];
+    MutStream s = mut_stream_new(buf, sizeof buf, STREAM_LITTLE_ENDIAN);
+    mut_stream_write_i32_array(&s, nums, 9);
+    cr_assert_arr_eq(buf + 8 * sizeof(i32), le_payload + i32_offset,
+                     sizeof(i32));
+
+    i32 res[9];
+    mut_stream_seek(&s, 0, STREAM_START);
+    mut_stream_read_i32_array(&s, res, 9);
+    cr_assert_arr_eq(res, nums, sizeof nums);
+}
+
+Test(TestMutStream, test_mut_stream_growable)
+{
+    MutStream s = mut_stream_new_growable(0, STREAM_BIG_ENDIAN);
+    cr_assert(eq(u64, mut_stream_size(&s), 0));
+
+    for (u64 i = 0; i < 100; ++i) {
+        mut_stream_write_u8(&s, u8_expected);
+        mut_stream_write_u16(&s, u16_expected);
+        mut_stream_write_u32_be(&s, u32_expected);
+        mut_stream_write_u64(&s, u64_expected);
+    }
+    cr_assert(eq(u64, mut_stream_size(&s), 100 * u64_offset + 800));
+    cr_assert(ge(u64, mut_stream_capacity(&s), mut_stream_size(&s)));
+
+    for (u64 i = 0; i < 100; ++i) {
+        cr_assert_arr_eq(mut_stream_raw(&s) + i * (u64_offset + 8),
+                         be_payload, u64_offset + 8);
+    }
+
+    mut_stream_seek(&s, 1, STREAM_START);
+    mut_stream_write_u16(&s, 0);
+    cr_assert(eq(u64, mut_stream_size(&s), 100 * u64_offset + 800));
+    mut_stream_seek(&s, 0, STREAM_END);
+    cr_assert(eq(u64, mut_stream_tell(&s), mut_stream_size(&s)));
+
+    mut_stream_free(&s);
+    cr_assert(eq(u64, mut_stream_size(&s), 0));
+}
+
+Test(TestMutStream, test_mut_stream_growable_reserve_and_take)
+{
+    MutStream s = mut_stream_new_growable_le(4);
+    mut_stream_reserve(&s, 1000);
+    cr_assert(ge(u64, mut_stream_capacity(&s), 1000));
+    u8 const* raw = mut_stream_raw(&s);
+
+    u64 nums[100];
+    for (u64 i = 0; i < 100; ++i) {
+        nums[i] = i;
+    }
+    mut_stream_write_u64_array(&s, nums, 100);
+    cr_assert(raw == mut_stream_raw(&s));
+
+    u64 size;
+    u8* buf = mut_stream_take(&s, &size);
+    cr_assert(buf == raw);
+    cr_assert(eq(u64, size, sizeof nums));
+    cr_assert_arr_eq(buf, nums, sizeof nums);
+    cr_assert(eq(u64, mut_stream_size(&s), 0));
+    free(buf);
+}
+
+Test(TestMutStream, test_mut_stream_write_varint)
+{
+    u8 expected[] = { 0xac, 0x02, 0x9c, 0xff, 0xff, 0xff, 0xff,
+                      0xff, 0xff, 0xff, 0xff, 0x01, 0x01, 0x7f };
+
+    u8 buf[sizeof expected];
+    MutStream s = mut_stream_new(buf, sizeof buf, STREAM_BIG_ENDIAN);
+    mut_stream_write_varint_u64(&s, 300);
+    mut_stream_write_varint_u64(&s, u64_expected);
+    mut_stream_write_varint_i64(&s, -1);
+    mut_stream_write_varint_i64(&s, -64);
+    cr_assert(eq(u64, mut_stream_tell(&s), sizeof expected));
+    cr_assert_arr_eq(buf, expected, sizeof expected);
+}
+
 typedef struct {
     i32 page_id;
     i16 offset;
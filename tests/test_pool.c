@@ -0,0 +1,135 @@
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <criterion/criterion.h>
+#include <criterion/new/assert.h>
+
+#include "nclib/alloc/pool.h"
+
+typedef struct {
+    u64 key;
+    u8 tag;
+} Node;
+
+#define THREADS_COUNT 4
+#define THREAD_NODES 10000
+
+Test(TestPool, test_pool_alloc_release)
+{
+    Pool pool = pool_new_for(Node, 4);
+
+    Node* first = pool_alloc(&pool);
+    Node* second = pool_alloc(&pool);
+    first->key = 1;
+    second->key = 2;
+
+    cr_assert(eq(u64, (uintptr_t)first % _Alignof(Node), 0));
+    cr_assert(eq(u64, (uintptr_t)second % _Alignof(Node), 0));
+    cr_assert(ne(ptr, first, second));
+    cr_assert(eq(u64, pool_in_use(&pool), 2));
+
+    // Released slot is reused first.
+    pool_release(&pool, first);
+    cr_assert(eq(ptr, pool_alloc(&pool), first));
+
+    // More slots than one slab holds.
+    for (u64 i = 0; i < 10; ++i) {
+        Node* node = pool_alloc(&pool);
+        node->key = i;
+    }
+    cr_assert(eq(u64, pool_in_use(&pool), 12));
+    cr_assert(eq(u64, pool_high_water(&pool), 12));
+
+    pool_free(&pool);
+    cr_assert(eq(u64, pool_in_use(&pool), 0));
+}
+
+Test(TestPool, test_pool_aligned_slots)
+{
+    Pool pool = pool_new(3, 64, 0);
+
+    for (u64 i = 0; i < 100; ++i) {
+        cr_assert(eq(u64, (uintptr_t)pool_alloc(&pool) % 64, 0));
+    }
+
+    pool_free(&pool);
+}
+
+Test(TestPool, test_pool_cache)
+{
+    Pool pool = pool_new_for(Node, 0);
+    PoolCache cache = pool_cache_new(&pool);
+    Node* nodes[1000];
+
+    for (u64 i = 0; i < 1000; ++i) {
+        nodes[i] = pool_cache_new_item(&cache, Node);
+        nodes[i]->key = i;
+        nodes[i]->tag = (u8)i;
+    }
+    for (u64 i = 0; i < 1000; ++i) {
+        cr_assert(eq(u64, nodes[i]->key, i));
+    }
+    for (u64 i = 0; i < 600; ++i) {
+        pool_cache_release(&cache, nodes[i]);
+    }
+
+    pool_cache_flush(&cache);
+    cr_assert(eq(u64, pool_in_use(&pool), 400));
+    cr_assert(eq(u64, pool_high_water(&pool), 1000));
+
+    // Slots go back to other cache.
+    PoolCache other = pool_cache_new(&pool);
+    for (u64 i = 600; i < 1000; ++i) {
+        pool_cache_release(&other, nodes[i]);
+    }
+    pool_cache_flush(&other);
+    cr_assert(eq(u64, pool_in_use(&pool), 0));
+
+    pool_free(&pool);
+}
+
+static void* alloc_nodes(void* arg)
+{
+    Pool* pool = arg;
+    PoolCache cache = pool_cache_new(pool);
+    Node** nodes = malloc(THREAD_NODES * sizeof *nodes);
+    u64 errors = 0;
+
+    for (u64 round = 0; round < 10; ++round) {
+        for (u64 i = 0; i < THREAD_NODES; ++i) {
+            nodes[i] = pool_cache_new_item(&cache, Node);
+            nodes[i]->key = (uintptr_t)nodes[i];
+        }
+        for (u64 i = 0; i < THREAD_NODES; ++i) {
+            errors += nodes[i]->key != (uintptr_t)nodes[i];
+            pool_cache_release(&cache, nodes[i]);
+        }
+    }
+
+    pool_cache_flush(&cache);
+    free(nodes);
+    return (void*)(uintptr_t)errors;
+}
+
+Test(TestPool, test_pool_threads)
+{
+    Pool pool = pool_new_for(Node, 0);
+    pthread_t threads[THREADS_COUNT];
+
+    for (u64 i = 0; i < THREADS_COUNT; ++i) {
+        pthread_create(&threads[i], NULL, alloc_nodes, &pool);
+    }
+    for (u64 i = 0; i < THREADS_COUNT; ++i) {
+        void* errors;
+        pthread_join(threads[i], &errors);
+        cr_assert(eq(ptr, errors, NULL));
+    }
+
+    cr_assert(eq(u64, pool_in_use(&pool), 0));
+    cr_assert(ge(u64, pool_high_water(&pool), THREAD_NODES));
+    cr_assert(le(u64, pool_high_water(&pool),
+                 THREADS_COUNT * (THREAD_NODES + POOL_CACHE_BATCH)));
+
+    pool_free(&pool);
+}
@@ -0,0 +1,145 @@
+#include <pthread.h>
+#include <sched.h>
+
+#include <criterion/criterion.h>
+#include <criterion/new/assert.h>
+
+#include "nclib/streams/ring_stream.h"
+
+#define MESSAGES_COUNT 100000
+
+Test(TestRingStream, test_ring_stream_round_trip)
+{
+    RingStream ring = ring_stream_new_be(64);
+    MutStream out;
+    Stream in;
+
+    cr_assert(not ring_stream_try_read_begin(&ring, &in));
+
+    cr_assert(ring_stream_try_write_begin(&ring, 16, &out));
+    mut_stream_write_u32(&out, 0xdeadbeef);
+    mut_stream_write_u16(&out, 7);
+    ring_stream_write_commit(&ring, &out);
+
+    cr_assert(ring_stream_try_read_begin(&ring, &in));
+    cr_assert(eq(u64, stream_size(&in), 6));
+    cr_assert(eq(u32, stream_read_u32(&in), 0xdeadbeef));
+    cr_assert(eq(u16, stream_read_u16(&in), 7));
+    ring_stream_read_commit(&ring);
+
+    cr_assert(not ring_stream_try_read_begin(&ring, &in));
+
+    ring_stream_free(&ring);
+}
+
+Test(TestRingStream, test_ring_stream_full_and_wrap)
+{
+    RingStream ring = ring_stream_new_le(64);
+    MutStream out;
+    Stream in;
+
+    // Two slots of 24 bytes leave no room for big message.
+    for (u32 i = 0; i < 2; ++i) {
+        cr_assert(ring_stream_try_write_begin(&ring, 20, &out));
+        for (u32 j = 0; j < 5; ++j) {
+            mut_stream_write_u32(&out, i);
+        }
+        ring_stream_write_commit(&ring, &out);
+    }
+    cr_assert(not ring_stream_try_write_begin(&ring, 28, &out));
+
+    // Space is freed only by commit.
+    cr_assert(ring_stream_try_read_begin(&ring, &in));
+    cr_assert(eq(u32, stream_read_u32(&in), 0));
+    cr_assert(not ring_stream_try_write_begin(&ring, 16, &out));
+    ring_stream_read_commit(&ring);
+
+    // Message doesn't fit last 16 bytes and goes to freed beginning.
+    cr_assert(ring_stream_try_write_begin(&ring, 16, &out));
+    mut_stream_write_u64(&out, 42);
+    ring_stream_write_commit(&ring, &out);
+
+    cr_assert(ring_stream_try_read_begin(&ring, &in));
+    cr_assert(eq(u32, stream_read_u32(&in), 1));
+    cr_assert(ring_stream_try_read_begin(&ring, &in));
+    cr_assert(eq(u64, stream_size(&in), 8));
+    cr_assert(eq(u64, stream_read_u64(&in), 42));
+    ring_stream_read_commit(&ring);
+    cr_assert(not ring_stream_try_read_begin(&ring, &in));
+
+    ring_stream_free(&ring);
+}
+
+Test(TestRingStream, test_ring_stream_big_message_after_wrap)
+{
+    RingStream ring = ring_stream_new_le(128);
+    MutStream out;
+    Stream in;
+
+    for (u32 i = 0; i < 2; ++i) {
+        cr_assert(ring_stream_try_write_begin(&ring, 36, &out));
+        mut_stream_write_u32(&out, i);
+        ring_stream_write_commit(&ring, &out);
+        cr_assert(ring_stream_try_read_begin(&ring, &in));
+        ring_stream_read_commit(&ring);
+    }
+
+    // Biggest message doesn't fit last 48 bytes, but fits empty ring with
+    // wrap marker, every time.
+    for (u32 i = 0; i < 4; ++i) {
+        cr_assert(ring_stream_try_write_begin(&ring, 60, &out));
+        mut_stream_write_u32(&out, i);
+        ring_stream_write_commit(&ring, &out);
+        cr_assert(ring_stream_try_read_begin(&ring, &in));
+        cr_assert(eq(u32, stream_read_u32(&in), i));
+        ring_stream_read_commit(&ring);
+    }
+
+    ring_stream_free(&ring);
+}
+
+static void* produce(void* arg)
+{
+    RingStream* ring = arg;
+    MutStream out;
+
+    for (u32 i = 0; i < MESSAGES_COUNT; ++i) {
+        while (not ring_stream_try_write_begin(ring, 64, &out)) {
+            sched_yield();
+        }
+        mut_stream_write_u32(&out, i);
+        for (u32 j = 0; j < i % 8; ++j) {
+            mut_stream_write_u64(&out, (u64)i * j);
+        }
+        ring_stream_write_commit(ring, &out);
+    }
+
+    return NULL;
+}
+
+Test(TestRingStream, test_ring_stream_threads)
+{
+    RingStream ring = ring_stream_new_le(1024);
+    pthread_t producer;
+    pthread_create(&producer, NULL, produce, &ring);
+
+    u64 errors = 0;
+    Stream in;
+    for (u32 i = 0; i < MESSAGES_COUNT; ++i) {
+        while (not ring_stream_try_read_begin(&ring, &in)) {
+            sched_yield();
+        }
+        errors += stream_read_u32(&in) != i;
+        errors += stream_size(&in) != 4 + 8 * (i % 8);
+        for (u32 j = 0; j < i % 8; ++j) {
+            errors += stream_read_u64(&in) != (u64)i * j;
+        }
+        ring_stream_read_commit(&ring);
+    }
+
+    pthread_join(producer, NULL);
+    cr_assert(eq(u64, errors, 0));
+    cr_assert(not ring_stream_try_read_begin(&ring, &in));
+
+    ring_stream_free(&ring);
+}
@@ -0,0 +1,105 @@
+#include <string.h>
+
+#include <criterion/criterion.h>
+#include <criterion/new/assert.h>
+
+#include "nclib/str/str.h"
+
+char const* short_cstr = "hello";
+char const* long_cstr = "hello, this string doesn't fit inline";
+
+Test(TestStr, test_str_new)
+{
+    Str str = str_new();
+
+    cr_assert(eq(u64, str_len(&str), 0));
+    cr_assert(str_is_inline(&str));
+    cr_assert(eq(i32, strcmp(str_cstr(&str), ""), 0));
+}
+
+Test(TestStr, test_str_from_cstr_inline)
+{
+    Str str = str_from_cstr(short_cstr);
+
+    cr_assert(str_is_inline(&str));
+    cr_assert(eq(u64, str_len(&str), 5));
+    cr_assert(eq(u64, str_capacity(&str), STR_INLINE_CAPACITY));
+    cr_assert(eq(i32, strcmp(str_cstr(&str), short_cstr), 0));
+    str_free(&str);
+}
+
+Test(TestStr, test_str_from_cstr_heap)
+{
+    Str str = str_from_cstr(long_cstr);
+
+    cr_assert(not str_is_inline(&str));
+    cr_assert(eq(u64, str_len(&str), strlen(long_cstr)));
+    cr_assert(eq(i32, strcmp(str_cstr(&str), long_cstr), 0));
+    str_free(&str);
+}
+
+Test(TestStr, test_str_append_moves_to_heap)
+{
+    Str str = str_from_cstr("0123456789");
+
+    str_append(&str, str_view_from_cstr("abcde"));
+    cr_assert(str_is_inline(&str));
+
+    str_push(&str, 'f');
+    cr_assert(not str_is_inline(&str));
+    cr_assert(eq(u64, str_len(&str), 16));
+    cr_assert(eq(i32, strcmp(str_cstr(&str), "0123456789abcdef"), 0));
+    str_free(&str);
+}
+
+Test(TestStr, test_str_reserve)
+{
+    Str str = str_with_capacity(100);
+
+    cr_assert(ge(u64, str_capacity(&str), 100));
+    cr_assert(eq(u64, str_len(&str), 0));
+    cr_assert(eq(i32, strcmp(str_cstr(&str), ""), 0));
+    str_free(&str);
+}
+
+Test(TestStr, test_str_clear)
+{
+    Str str = str_from_cstr(long_cstr);
+    u64 capacity = str_capacity(&str);
+
+    str_clear(&str);
+
+    cr_assert(eq(u64, str_len(&str), 0));
+    cr_assert(eq(u64, str_capacity(&str), capacity));
+    cr_assert(eq(i32, strcmp(str_cstr(&str), ""), 0));
+    str_free(&str);
+}
+
+Test(TestStr, test_str_view)
+{
+    Str str = str_from_cstr(long_cstr);
+    StrView view = str_view(&str);
+
+    cr_assert(eq(ptr, (void*)view.ptr, (void*)str_cstr(&str)));
+    cr_assert(eq(u64, view.len, str_len(&str)));
+    str_free(&str);
+}
+
+Test(TestStr, test_str_append_self)
+{
+    // Inline chars move to heap.
+    Str str = str_from_cstr("0123456789");
+    str_append(&str, str_view(&str));
+
+    cr_assert(not str_is_inline(&str));
+    cr_assert(eq(i32, strcmp(str_cstr(&str), "01234567890123456789"), 0));
+
+    // Heap chars are reallocated.
+    str_append(&str, str_view(&str));
+    str_append(&str, str_view_new(str_cstr(&str) + 38, 2));
+
+    cr_assert(eq(u64, str_len(&str), 42));
+    cr_assert(eq(i32, strncmp(str_cstr(&str), str_cstr(&str) + 20, 20), 0));
+    cr_assert(eq(i32, strcmp(str_cstr(&str) + 38, "8989"), 0));
+    str_free(&str);
+}
@@ -0,0 +1,76 @@
+#include <criterion/criterion.h>
+#include <criterion/new/assert.h>
+
+#include "nclib/str/str_view.h"
+
+char const* text = "the quick brown fox jumps over the lazy dog, the end";
+
+Test(TestStrView, test_str_view_eq)
+{
+    StrView view = str_view_from_cstr(text);
+
+    cr_assert(str_view_eq(view, str_view_from_cstr(text)));
+    cr_assert(not str_view_eq(view, str_view_new(text, 10)));
+    cr_assert(not str_view_eq(str_view_new(text, 30),
+                              str_view_new(text + 1, 30)));
+    cr_assert(str_view_eq(str_view_new(NULL, 0), str_view_from_cstr("")));
+}
+
+Test(TestStrView, test_str_view_starts_ends_with)
+{
+    StrView view = str_view_from_cstr(text);
+
+    cr_assert(str_view_starts_with(view, str_view_from_cstr("the quick")));
+    cr_assert(not str_view_starts_with(view, str_view_from_cstr("quick")));
+    cr_assert(str_view_ends_with(view, str_view_from_cstr("the end")));
+    cr_assert(not str_view_ends_with(str_view_from_cstr("end"), view));
+}
+
+Test(TestStrView, test_str_view_find_char)
+{
+    StrView view = str_view_from_cstr(text);
+
+    cr_assert(eq(u64, str_view_find_char(view, 't'), 0));
+    cr_assert(eq(u64, str_view_find_char(view, ','), 43));
+    cr_assert(eq(u64, str_view_find_char(view, 'd'), 40));
+    cr_assert(eq(u64, str_view_find_char(view, '!'), STR_NOT_FOUND));
+}
+
+Test(TestStrView, test_str_view_find)
+{
+    StrView view = str_view_from_cstr(text);
+
+    cr_assert(eq(u64, str_view_find(view, str_view_from_cstr("the")), 0));
+    cr_assert(eq(u64, str_view_find(view, str_view_from_cstr("lazy dog")), 35));
+    cr_assert(eq(u64, str_view_find(view, str_view_from_cstr("the end")), 45));
+    cr_assert(eq(u64, str_view_find(view, str_view_from_cstr("fox")), 16));
+    cr_assert(eq(u64, str_view_find(view, str_view_from_cstr("cat")),
+                 STR_NOT_FOUND));
+    cr_assert(eq(u64, str_view_find(view, str_view_from_cstr("")), 0));
+}
+
+Test(TestStrView, test_str_view_slice)
+{
+    StrView view = str_view_from_cstr(text);
+
+    cr_assert(str_view_eq(str_view_slice(view, 4, 5),
+                          str_view_from_cstr("quick")));
+    cr_assert(str_view_eq(str_view_slice(view, 45, 100),
+                          str_view_from_cstr("the end")));
+    cr_assert(eq(u64, str_view_slice(view, 100, 5).len, 0));
+}
+
+Test(TestStrView, test_str_view_split)
+{
+    StrView rest = str_view_from_cstr("a,bc,,d");
+    char const* expected[] = { "a", "bc", "", "d" };
+    StrView token;
+    u64 count = 0;
+
+    while (str_view_split(&rest, ',', &token)) {
+        cr_assert(str_view_eq(token, str_view_from_cstr(expected[count])));
+        ++count;
+    }
+
+    cr_assert(eq(u64, count, 4));
+}
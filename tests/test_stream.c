@@ -1,4 +1,5 @@
 #include <float.h>
+#include <string.h>
 
 #include <criterion/criterion.h>
 #include <criterion/new/assert.h>
@@ -363,6 +364,409 @@ Test(TestStream, test_stream_seek)
     cr_assert(eq(u8, res, void_payload[1]));
 }
 
+Test(TestStream, test_read_u16_be_inline)
+{
+    u8* payload_start = be_payload + u16_offset;
+    const u64 payload_size = sizeof be_payload - u16_offset;
+
+    Stream s = stream_new(payload_start, payload_size, STREAM_BIG_ENDIAN);
+    u16 res = stream_read_u16_be(&s);
+    cr_assert(eq(u16, res, u16_expected));
+    cr_assert(eq(u64, stream_tell(&s), sizeof res));
+}
+
+Test(TestStream, test_read_u16_le_inline)
+{
+    u8* payload_start = le_payload + u16_offset;
+    const u64 payload_size = sizeof le_payload - u16_offset;
+
+    Stream s = stream_new(payload_start, payload_size, STREAM_BIG_ENDIAN);
+    u16 res = stream_read_u16_le(&s);
+    cr_assert(eq(u16, res, u16_expected));
+    cr_assert(eq(u64, stream_tell(&s), sizeof res));
+}
+
+Test(TestStream, test_read_i32_be_inline)
+{
+    u8* payload_start = be_payload + i32_offset;
+    const u64 payload_size = sizeof be_payload - i32_offset;
+
+    Stream s = stream_new(payload_start, payload_size, STREAM_BIG_ENDIAN);
+    i32 res = stream_read_i32_be(&s);
+    cr_assert(eq(i32, res, i32_expected));
+    cr_assert(eq(u64, stream_tell(&s), sizeof res));
+}
+
+Test(TestStream, test_read_i32_le_inline)
+{
+    u8* payload_start = le_payload + i32_offset;
+    const u64 payload_size = sizeof le_payload - i32_offset;
+
+    Stream s = stream_new(payload_start, payload_size, STREAM_BIG_ENDIAN);
+    i32 res = stream_read_i32_le(&s);
+    cr_assert(eq(i32, res, i32_expected));
+    cr_assert(eq(u64, stream_tell(&s), sizeof res));
+}
+
+Test(TestStream, test_read_u64_be_inline)
+{
+    u8* payload_start = be_payload + u64_offset;
+    const u64 payload_size = sizeof be_payload - u64_offset;
+
+    Stream s = stream_new(payload_start, payload_size, STREAM_BIG_ENDIAN);
+    u64 res = stream_read_u64_be(&s);
+    cr_assert(eq(u64, res, u64_expected));
+    cr_assert(eq(u64, stream_tell(&s), sizeof res));
+}
+
+Test(TestStream, test_read_u64_le_inline)
+{
+    u8* payload_start = le_payload + u64_offset;
+    const u64 payload_size = sizeof le_payload - u64_offset;
+
+    Stream s = stream_new(payload_start, payload_size, STREAM_BIG_ENDIAN);
+    u64 res = stream_read_u64_le(&s);
+    cr_assert(eq(u64, res, u64_expected));
+    cr_assert(eq(u64, stream_tell(&s), sizeof res));
+}
+
+Test(TestStream, test_read_f64_be_inline)
+{
+    u8* payload_start = be_payload + f64_offset;
+    const u64 payload_size = sizeof be_payload - f64_offset;
+
+    Stream s = stream_new(payload_start, payload_size, STREAM_BIG_ENDIAN);
+    f64 res = stream_read_f64_be(&s);
+    cr_assert(eq(dbl, res, f64_expected));
+    cr_assert(eq(u64, stream_tell(&s), sizeof res));
+}
+
+Test(TestStream, test_read_f64_le_inline)
+{
+    u8* payload_start = le_payload + f64_offset;
+    const u64 payload_size = sizeof le_payload - f64_offset;
+
+    Stream s = stream_new(payload_start, payload_size, STREAM_BIG_ENDIAN);
+    f64 res = stream_read_f64_le(&s);
+    cr_assert(eq(dbl, res, f64_expected));
+    cr_assert(eq(u64, stream_tell(&s), sizeof res));
+}
+
+Test(TestStream, test_read_be_u32_array)
+{
+    u8 payload[37 * sizeof(u32)];
+    u32 expected[37];
+    for (u32 i = 0; i < 37; ++i) {
+        expected[i] = 0x01020304u * (i + 1);
+        payload[i * 4] = (u8)(expected[i] >> 24);
+        payload[i * 4 + 1] = (u8)(expected[i] >> 16);
+        payload[i * 4 + 2] = (u8)(expected[i] >> 8);
+        payload[i * 4 + 3] = (u8)expected[i];
+    }
+
+    Stream s = stream_new(payload, sizeof payload, STREAM_BIG_ENDIAN);
+    u32 res[37];
+    stream_read_u32_array(&s, res, 37);
+    cr_assert_arr_eq(res, expected, sizeof expected);
+    cr_assert(eq(u64, stream_tell(&s), sizeof payload));
+}
+
+Test(TestStream, test_read_le_u16_array)
+{
+    u8 payload[21 * sizeof(u16)];
+    u16 expected[21];
+    for (u16 i = 0; i < 21; ++i) {
+        expected[i] = (u16)(0x0102u * (i + 1));
+        payload[i * 2] = (u8)expected[i];
+        payload[i * 2 + 1] = (u8)(expected[i] >> 8);
+    }
+
+    Stream s = stream_new(payload, sizeof payload, STREAM_LITTLE_ENDIAN);
+    u16 res[21];
+    stream_read_u16_array(&s, res, 21);
+    cr_assert_arr_eq(res, expected, sizeof expected);
+}
+
+Test(TestStream, test_read_be_f64_array)
+{
+    u8 payload[3 * sizeof(f64)];
+    for (u64 i = 0; i < 3; ++i) {
+        memcpy(payload + i * 8, be_payload + f64_offset, sizeof(f64));
+    }
+
+    Stream s = stream_new(payload, sizeof payload, STREAM_BIG_ENDIAN);
+    f64 res[3];
+    stream_read_f64_array(&s, res, 3);
+    for (u64 i = 0; i < 3; ++i) {
+        cr_assert(eq(dbl, res[i], f64_expected));
+    }
+}
+
+Test(TestStream, test_stream_read_view)
+{
+    Stream s
+        = stream_new(void_payload, sizeof void_payload, STREAM_BIG_ENDIAN);
+    stream_read_u8(&s);
+
+    StreamView view = stream_read_view(&s, 3);
+    cr_assert(view.ptr == void_payload + 1);
+    cr_assert(eq(u64, view.size, 3));
+    cr_assert(eq(u64, stream_tell(&s), 4));
+}
+
+Test(TestStream, test_stream_substream)
+{
+    Stream s = stream_new(be_payload, sizeof be_payload, STREAM_BIG_ENDIAN);
+    stream_read_u8(&s);
+
+    Stream sub = stream_substream(&s, sizeof(u16) + sizeof(u32));
+    cr_assert(eq(u64, stream_tell(&s), u64_offset));
+    cr_assert(eq(u64, stream_size(&sub), sizeof(u16) + sizeof(u32)));
+    cr_assert(eq(u16, stream_read_u16(&sub), u16_expected));
+    cr_assert(eq(u32, stream_read_u32(&sub), u32_expected));
+
+    stream_seek(&sub, 0, STREAM_END);
+    cr_assert(eq(u64, stream_tell(&sub), stream_size(&sub)));
+    cr_assert(eq(u64, stream_read_u64(&s), u64_expected));
+}
+
+Test(TestStream, test_read_varint_u64)
+{
+    // 1, 300, 2^32 - 100, 2^64 - 100 and padding for fast path.
+    u8 payload[] = { 0x01, 0xac, 0x02, 0x9c, 0xff, 0xff, 0xff, 0x0f, 0x9c,
+                     0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01,
+                     0x0,  0x0,  0x0,  0x0,  0x0,  0x0,  0x0,  0x0,  0x0 };
+
+    Stream s = stream_new(payload, sizeof payload, STREAM_BIG_ENDIAN);
+    cr_assert(eq(u64, stream_read_varint_u64(&s), 1));
+    cr_assert(eq(u64, stream_read_varint_u64(&s), 300));
+    cr_assert(eq(u64, stream_read_varint_u64(&s), u32_expected));
+    cr_assert(eq(u64, stream_read_varint_u64(&s), u64_expected));
+    cr_assert(eq(u64, stream_tell(&s), 18));
+
+    // The same numbers at the end of buffer use slow path.
+    s = stream_new(payload, 18, STREAM_BIG_ENDIAN);
+    stream_seek(&s, 3, STREAM_START);
+    cr_assert(eq(u64, stream_read_varint_u64(&s), u32_expected));
+    cr_assert(eq(u64, stream_read_varint_u64(&s), u64_expected));
+    cr_assert(eq(u64, stream_tell(&s), 18));
+}
+
+Test(TestStream, test_read_varint_i64)
+{
+    // 0, -1, 1, -64, i64 min.
+    u8 payload[] = { 0x00, 0x01, 0x02, 0x7f, 0xff, 0xff, 0xff, 0xff,
+                     0xff, 0xff, 0xff, 0xff, 0xff, 0x01 };
+
+    Stream s = stream_new(payload, sizeof payload, STREAM_LITTLE_ENDIAN);
+    cr_assert(eq(i64, stream_read_varint_i64(&s), 0));
+    cr_assert(eq(i64, stream_read_varint_i64(&s), -1));
+    cr_assert(eq(i64, stream_read_varint_i64(&s), 1));
+    cr_assert(eq(i64, stream_read_varint_i64(&s), -64));
+    cr_assert(eq(i64, stream_read_varint_i64(&s), INT64_MIN));
+}
+
+Test(TestStream, test_stream_ensure)
+{
+    Stream s = stream_new_be(be_payload, sizeof be_payload);
+
+    cr_assert(stream_ensure(&s, sizeof be_payload));
+    cr_assert(not stream_ensure(&s, sizeof be_payload + 1));
+
+    stream_seek(&s, 3, STREAM_END);
+    cr_assert(stream_ensure(&s, 3));
+    cr_assert(not stream_ensure(&s, 4));
+    cr_assert(stream_ensure(&s, 0));
+}
+
+Test(TestStream, test_read_be_unchecked)
+{
+    Stream s = stream_new_be(be_payload, sizeof be_payload);
+    cr_assert(stream_ensure(&s, sizeof be_payload));
+
+    cr_assert(eq(u8, stream_read_u8_unchecked(&s), u8_expected));
+    cr_assert(eq(u16, stream_read_u16_unchecked(&s), u16_expected));
+    cr_assert(eq(u32, stream_read_u32_unchecked(&s), u32_expected));
+    cr_assert(eq(u64, stream_read_u64_unchecked(&s), u64_expected));
+    cr_assert(eq(i8, stream_read_i8_unchecked(&s), i8_expected));
+    cr_assert(eq(i16, stream_read_i16_unchecked(&s), i16_expected));
+    cr_assert(eq(i32, stream_read_i32_unchecked(&s), i32_expected));
+    cr_assert(eq(i64, stream_read_i64_unchecked(&s), i64_expected));
+    cr_assert(eq(flt, stream_read_f32_unchecked(&s), f32_expected));
+    cr_assert(eq(dbl, stream_read_f64_unchecked(&s), f64_expected));
+    cr_assert(eq(u8, stream_read_bool_unchecked(&s), bool1_expected));
+    cr_assert(eq(u8, stream_read_bool_unchecked(&s), bool2_expected));
+    cr_assert(eq(u64, stream_tell(&s), sizeof be_payload));
+}
+
+Test(TestStream, test_read_le_unchecked_fixed_endian)
+{
+    // Endian of stream is ignored by _le_unchecked methods.
+    Stream s = stream_new_be(le_payload, sizeof le_payload);
+    cr_assert(stream_ensure(&s, 15));
+
+    stream_seek(&s, (i64)u16_offset, STREAM_START);
+    cr_assert(eq(u16, stream_read_u16_le_unchecked(&s), u16_expected));
+    cr_assert(eq(u32, stream_read_u32_le_unchecked(&s), u32_expected));
+    cr_assert(eq(u64, stream_read_u64_le_unchecked(&s), u64_expected));
+
+    s = stream_new_le(be_payload, sizeof be_payload);
+    stream_seek(&s, (i64)u32_offset, STREAM_START);
+    cr_assert(eq(u32, stream_read_u32_be_unchecked(&s), u32_expected));
+}
+
+Test(TestStream, test_read_bytes_unchecked)
+{
+    Stream s = stream_new_le(void_payload, sizeof void_payload);
+    u8 dst[4];
+
+    stream_read_bytes_unchecked(&s, dst, 4);
+
+    cr_assert_arr_eq(dst, void_payload, 4);
+    cr_assert(eq(u64, stream_tell(&s), 4));
+}
+
+Test(TestStream, test_read_at)
+{
+    Stream const s = stream_new_be(be_payload, sizeof be_payload);
+
+    // Order of reads doesn't matter, stream doesn't move.
+    cr_assert(eq(u8, stream_read_bool_at(&s, bool2_offset), bool2_expected));
+    cr_assert(eq(dbl, stream_read_f64_at(&s, f64_offset), f64_expected));
+    cr_assert(eq(flt, stream_read_f32_at(&s, f32_offset), f32_expected));
+    cr_assert(eq(i64, stream_read_i64_at(&s, i64_offset), i64_expected));
+    cr_assert(eq(i32, stream_read_i32_at(&s, i32_offset), i32_expected));
+    cr_assert(eq(i16, stream_read_i16_at(&s, i16_offset), i16_expected));
+    cr_assert(eq(i8, stream_read_i8_at(&s, i8_offset), i8_expected));
+    cr_assert(eq(u64, stream_read_u64_at(&s, u64_offset), u64_expected));
+    cr_assert(eq(u32, stream_read_u32_at(&s, u32_offset), u32_expected));
+    cr_assert(eq(u16, stream_read_u16_at(&s, u16_offset), u16_expected));
+    cr_assert(eq(u8, stream_read_u8_at(&s, u8_offset), u8_expected));
+    cr_assert(eq(u64, stream_tell(&s), 0));
+}
+
+Test(TestStream, test_read_at_fixed_endian)
+{
+    // Endian of stream is ignored by _le_at and _be_at methods.
+    Stream const le = stream_new_be(le_payload, sizeof le_payload);
+    Stream const be = stream_new_le(be_payload, sizeof be_payload);
+
+    cr_assert(eq(u16, stream_read_u16_le_at(&le, u16_offset), u16_expected));
+    cr_assert(eq(i32, stream_read_i32_le_at(&le, i32_offset), i32_expected));
+    cr_assert(eq(dbl, stream_read_f64_le_at(&le, f64_offset), f64_expected));
+    cr_assert(eq(u64, stream_read_u64_be_at(&be, u64_offset), u64_expected));
+    cr_assert(eq(i16, stream_read_i16_be_at(&be, i16_offset), i16_expected));
+    cr_assert(eq(flt, stream_read_f32_be_at(&be, f32_offset), f32_expected));
+}
+
+Test(TestStream, test_read_bytes_at)
+{
+    Stream const s = stream_new_le(void_payload, sizeof void_payload);
+    u8 dst[4];
+
+    stream_read_bytes_at(&s, 2, dst, 4);
+
+    cr_assert_arr_eq(dst, void_payload + 2, 4);
+    cr_assert(eq(u64, stream_tell(&s), 0));
+}
+
+Test(TestStream, test_fallible_read_at_out_of_bound)
+{
+    u8 buf[] = { 0x01, 0x02, 0x03 };
+    Stream const s = stream_new_fallible_le(buf, sizeof buf);
+    u8 dst[2] = { 0xff, 0xff };
+
+    cr_assert(eq(u16, stream_read_u16_at(&s, 1), 0x0302));
+    cr_assert(eq(u16, stream_read_u16_at(&s, 2), 0));
+    cr_assert(eq(u32, stream_read_u32_be_at(&s, 0), 0));
+    cr_assert(eq(u8, stream_read_u8_at(&s, UINT64_MAX), 0));
+
+    stream_read_bytes_at(&s, 2, dst, 2);
+    cr_assert(eq(u8, dst[0], 0));
+    cr_assert(eq(u8, dst[1], 0));
+
+    // Const stream keeps no error.
+    cr_assert(not stream_has_error(&s));
+}
+
+Test(TestStream, test_fallible_read_in_bound)
+{
+    Stream s = stream_new_fallible_be(be_payload, sizeof be_payload);
+
+    cr_assert(stream_is_fallible(&s));
+    cr_assert(eq(u8, stream_read_u8(&s), u8_expected));
+    cr_assert(eq(u16, stream_read_u16(&s), u16_expected));
+    cr_assert(eq(u32, stream_read_u32_be(&s), u32_expected));
+    cr_assert(eq(u64, stream_read_u64(&s), u64_expected));
+    cr_assert(not stream_has_error(&s));
+}
+
+Test(TestStream, test_fallible_read_out_of_bound)
+{
+    u8 buf[] = { 0x01, 0x02, 0x03 };
+    Stream s = stream_new_fallible_le(buf, sizeof buf);
+
+    cr_assert(eq(u16, stream_read_u16(&s), 0x0201));
+    cr_assert(eq(u32, stream_read_u32(&s), 0));
+    cr_assert(stream_has_error(&s));
+    cr_assert(eq(u64, stream_tell(&s), sizeof buf));
+
+    // Error is sticky, stream stays at the end.
+    cr_assert(eq(u8, stream_read_u8(&s), 0));
+    cr_assert(eq(u64, stream_read_u64_le(&s), 0));
+    cr_assert(eq(i64, stream_read_varint_i64(&s), 0));
+    cr_assert(stream_has_error(&s));
+
+    stream_clear_error(&s);
+    cr_assert(not stream_has_error(&s));
+}
+
+Test(TestStream, test_fallible_read_bytes_and_arrays)
+{
+    u8 buf[] = { 0x01, 0x02, 0x03, 0x04, 0x05 };
+    Stream s = stream_new_fallible_be(buf, sizeof buf);
+    u16 nums[3] = { 7, 7, 7 };
+    u16 zeros[3] = { 0, 0, 0 };
+
+    stream_read_u16_array(&s, nums, 3);
+    cr_assert_arr_eq(nums, zeros, sizeof nums);
+    cr_assert(stream_has_error(&s));
+
+    u8 dst[2] = { 7, 7 };
+    stream_seek(&s, 4, STREAM_START);
+    stream_read_bytes(&s, dst, 2);
+    cr_assert(eq(u8, dst[0], 0));
+    cr_assert(eq(u8, dst[1], 0));
+
+    StreamView view = stream_read_view(&s, 1);
+    cr_assert(eq(u64, view.size, 0));
+}
+
+Test(TestStream, test_fallible_varint_truncated)
+{
+    u8 buf[] = { 0x80, 0x80 };
+    Stream s = stream_new_fallible_le(buf, sizeof buf);
+
+    cr_assert(eq(u64, stream_read_varint_u64(&s), 0));
+    cr_assert(stream_has_error(&s));
+}
+
+Test(TestStream, test_fallible_substream)
+{
+    u8 buf[] = { 0x01, 0x02, 0x03, 0x04 };
+    Stream s = stream_new_fallible_be(buf, sizeof buf);
+    Stream sub = stream_substream(&s, 2);
+
+    cr_assert(stream_is_fallible(&sub));
+    cr_assert(eq(u16, stream_read_u16(&sub), 0x0102));
+    cr_assert(eq(u8, stream_read_u8(&sub), 0));
+    cr_assert(stream_has_error(&sub));
+    cr_assert(not stream_has_error(&s));
+
+    cr_assert(eq(u16, stream_read_u16(&s), 0x0304));
+    cr_assert(not stream_has_error(&s));
+}
+
 typedef struct {
     i32 page_id;
     i16 offset;
@@ -0,0 +1,79 @@
+#include <string.h>
+
+#include <criterion/criterion.h>
+#include <criterion/new/assert.h>
+
+#include "nclib/streams/stream_arena.h"
+
+u8 be_payload[] = { 0x9c, 0xff, 0x9c, 0xff, 0xff, 0xff, 0x9c };
+
+// Varint length 5 and "hello", varint length 2 and two bytes.
+u8 var_payload[] = { 0x05, 'h', 'e', 'l', 'l', 'o', 0x02, 0xab, 0xcd };
+
+Test(TestStreamArena, test_stream_read_bytes_arena)
+{
+    Arena arena = arena_new(0);
+    Stream stream = stream_new_be(be_payload, sizeof be_payload);
+
+    u8* bytes = stream_read_bytes_arena(&stream, &arena, 3);
+
+    cr_assert_arr_eq(bytes, be_payload, 3);
+    cr_assert(eq(u64, stream_tell(&stream), 3));
+    arena_free(&arena);
+}
+
+Test(TestStreamArena, test_stream_read_varstr_arena)
+{
+    Arena arena = arena_new(0);
+    Stream stream = stream_new_be(var_payload, sizeof var_payload);
+
+    u64 len = 0;
+    char* str = stream_read_varstr_arena(&stream, &arena, &len);
+    cr_assert(eq(u64, len, 5));
+    cr_assert(eq(i32, strcmp(str, "hello"), 0));
+
+    u64 size = 0;
+    u8* bytes = stream_read_varbytes_arena(&stream, &arena, &size);
+    cr_assert(eq(u64, size, 2));
+    cr_assert(eq(u8, bytes[0], 0xab));
+    cr_assert(eq(u8, bytes[1], 0xcd));
+
+    arena_free(&arena);
+}
+
+Test(TestStreamArena, test_stream_read_u16_array_arena)
+{
+    Arena arena = arena_new(0);
+    Stream stream = stream_new_be(be_payload, sizeof be_payload);
+
+    u16* nums = stream_read_u16_array_arena(&stream, &arena, 3);
+
+    cr_assert(eq(u16, nums[0], 0x9cff));
+    cr_assert(eq(u16, nums[1], 0x9cff));
+    cr_assert(eq(u16, nums[2], 0xffff));
+    arena_free(&arena);
+}
+
+Test(TestStreamArena, test_fallible_huge_length)
+{
+    Arena arena = arena_new(0);
+
+    // Varint length UINT64_MAX followed by two bytes.
+    u8 huge[] = { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01,
+                  'h',  'i' };
+    Stream stream = stream_new_fallible_be(huge, sizeof huge);
+
+    u64 len = 1;
+    char* str = stream_read_varstr_arena(&stream, &arena, &len);
+    cr_assert(eq(u64, len, 0));
+    cr_assert(eq(i32, strcmp(str, ""), 0));
+    cr_assert(stream_has_error(&stream));
+
+    stream = stream_new_fallible_be(be_payload, sizeof be_payload);
+    cr_assert(eq(ptr, stream_read_u32_array_arena(&stream, &arena, 2), NULL));
+    cr_assert(eq(ptr, stream_read_u64_array_arena(&stream, &arena, UINT64_MAX),
+                 NULL));
+    cr_assert(stream_has_error(&stream));
+
+    arena_free(&arena);
+}
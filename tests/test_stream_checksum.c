@@ -0,0 +1,56 @@
+#include <criterion/criterion.h>
+#include <criterion/new/assert.h>
+
+#include "nclib/checksum/crc32c.h"
+#include "nclib/streams/stream_checksum.h"
+
+u8 frame[] = { 0x00, 0x05, 'h', 'e', 'l', 'l', 'o', 0x01, 0x02, 0x03 };
+
+Test(TestStreamChecksum, test_stream_checksum_region)
+{
+    Stream stream = stream_new_be(frame, sizeof frame);
+    stream_read_u16(&stream);
+
+    StreamChecksum checksum = stream_checksum_begin(&stream);
+    u8 payload[5];
+    stream_read_bytes(&stream, payload, sizeof payload);
+    stream_read_u8(&stream);
+    u32 crc = stream_checksum_end(&checksum, &stream);
+
+    cr_assert(eq(u32, crc, crc32c(0, frame + 2, 6)));
+}
+
+Test(TestStreamChecksum, test_stream_checksum_update)
+{
+    Stream stream = stream_new_le(frame, sizeof frame);
+    StreamChecksum checksum = stream_checksum_begin(&stream);
+
+    for (u64 i = 0; i < sizeof frame; ++i) {
+        stream_read_u8(&stream);
+        stream_checksum_update(&checksum, &stream);
+    }
+
+    // Bytes read again after seek back are not hashed twice.
+    stream_seek(&stream, 4, STREAM_START);
+    stream_read_u16(&stream);
+
+    cr_assert(eq(u32, stream_checksum_end(&checksum, &stream),
+                 crc32c(0, frame, sizeof frame)));
+}
+
+Test(TestStreamChecksum, test_mut_stream_checksum_growable)
+{
+    MutStream stream = mut_stream_new_growable_be(2);
+    mut_stream_write_u8(&stream, 0xaa);
+
+    StreamChecksum checksum = mut_stream_checksum_begin(&stream);
+    for (u32 i = 0; i < 100; ++i) {
+        mut_stream_write_u32(&stream, i);
+        mut_stream_checksum_update(&checksum, &stream);
+    }
+    u32 crc = mut_stream_checksum_end(&checksum, &stream);
+
+    cr_assert(eq(u32, crc, crc32c(0, mut_stream_raw(&stream) + 1, 400)));
+
+    mut_stream_free(&stream);
+}
@@ -0,0 +1,122 @@
+#include <criterion/criterion.h>
+#include <criterion/new/assert.h>
+
+#include "nclib/streams/stream_columns.h"
+#include "nclib/streams/stream_record.h"
+
+#define ADDR_FIELDS(X)                                                        \
+    X(i32, page_id)                                                           \
+    X(i16, offset)
+
+STREAM_RECORD_DEFINE(Addr, addr, ADDR_FIELDS)
+
+// Every field size, 15 bytes per record.
+#define ROW_FIELDS(X)                                                         \
+    X(u8, tag)                                                                \
+    X(u16, kind)                                                              \
+    X(u32, id)                                                                \
+    X(u64, value)
+
+STREAM_RECORD_DEFINE(Row, row, ROW_FIELDS)
+
+// Crosses block of 256 records and leaves tail for scalar code.
+#define ROWS_COUNT 1003
+
+static Row make_row(u64 i)
+{
+    return (Row) {
+        .tag = (u8)(i * 7),
+        .kind = (u16)(i * 40503),
+        .id = (u32)(i * 2654435761u),
+        .value = i * 0x9e3779b97f4a7c15u,
+    };
+}
+
+// Addr {.page_id = 100, .offset=234} and {.page_id = -2, .offset=-3}
+u8 be_addrs[] = { 0x0,  0x0,  0x0,  0x64, 0x0,  0xea,
+                  0xff, 0xff, 0xff, 0xfe, 0xff, 0xfd };
+
+Test(TestStreamColumns, test_layout)
+{
+    StreamColumnsLayout layout = STREAM_COLUMNS_LAYOUT(ROW_FIELDS);
+
+    cr_assert(eq(u64, layout.count, 4));
+    cr_assert(eq(u8, layout.sizes[0], 1));
+    cr_assert(eq(u8, layout.sizes[3], 8));
+    cr_assert(eq(u64, stream_columns_record_size(layout), row_wire_size()));
+}
+
+Test(TestStreamColumns, test_stream_read_columns_addr)
+{
+    Stream stream = stream_new_be(be_addrs, sizeof be_addrs);
+    i32 page_ids[2];
+    i16 offsets[2];
+
+    stream_read_columns(&stream, STREAM_COLUMNS_LAYOUT(ADDR_FIELDS),
+                        (void*[]) { page_ids, offsets }, 2);
+
+    cr_assert(eq(i32, page_ids[0], 100));
+    cr_assert(eq(i32, page_ids[1], -2));
+    cr_assert(eq(i16, offsets[0], 234));
+    cr_assert(eq(i16, offsets[1], -3));
+    cr_assert(eq(u64, stream_tell(&stream), sizeof be_addrs));
+}
+
+Test(TestStreamColumns, test_columns_match_records)
+{
+    StreamEndian endians[] = { STREAM_LITTLE_ENDIAN, STREAM_BIG_ENDIAN };
+    StreamColumnsLayout layout = STREAM_COLUMNS_LAYOUT(ROW_FIELDS);
+
+    static u8 tags[ROWS_COUNT];
+    static u16 kinds[ROWS_COUNT];
+    static u32 ids[ROWS_COUNT];
+    static u64 values[ROWS_COUNT];
+
+    for (u64 e = 0; e < 2; ++e) {
+        MutStream rows = mut_stream_new_growable(64, endians[e]);
+        for (u64 i = 0; i < ROWS_COUNT; ++i) {
+            mut_stream_write_row(&rows, make_row(i));
+        }
+
+        Stream stream = stream_new(mut_stream_raw(&rows),
+                                   mut_stream_tell(&rows), endians[e]);
+        stream_read_columns(&stream, layout,
+                            (void*[]) { tags, kinds, ids, values },
+                            ROWS_COUNT);
+        cr_assert(eq(u64, stream_tell(&stream), stream_size(&stream)));
+
+        for (u64 i = 0; i < ROWS_COUNT; ++i) {
+            Row row = make_row(i);
+            cr_assert(eq(u8, tags[i], row.tag));
+            cr_assert(eq(u16, kinds[i], row.kind));
+            cr_assert(eq(u32, ids[i], row.id));
+            cr_assert(eq(u64, values[i], row.value));
+        }
+
+        MutStream columns = mut_stream_new_growable(64, endians[e]);
+        mut_stream_write_columns(&columns, layout,
+                                 (void const*[]) { tags, kinds, ids, values },
+                                 ROWS_COUNT);
+
+        cr_assert(eq(u64, mut_stream_tell(&columns), mut_stream_tell(&rows)));
+        cr_assert_arr_eq(mut_stream_raw(&columns), mut_stream_raw(&rows),
+                         mut_stream_tell(&rows));
+
+        mut_stream_free(&columns);
+        mut_stream_free(&rows);
+    }
+}
+
+Test(TestStreamColumns, test_stream_read_columns_fallible)
+{
+    Stream stream = stream_new_fallible_be(be_addrs, sizeof be_addrs - 1);
+    i32 page_ids[2] = { 1, 1 };
+    i16 offsets[2] = { 1, 1 };
+
+    stream_read_columns(&stream, STREAM_COLUMNS_LAYOUT(ADDR_FIELDS),
+                        (void*[]) { page_ids, offsets }, 2);
+
+    cr_assert(stream_has_error(&stream));
+    cr_assert(eq(i32, page_ids[1], 0));
+    cr_assert(eq(i16, offsets[0], 0));
+}
@@ -0,0 +1,184 @@
+#include <criterion/criterion.h>
+#include <criterion/new/assert.h>
+
+#include "nclib/streams/stream_lz4.h"
+
+static u8 text[200000];
+static u8 noise[5000];
+
+static void fill_data(void)
+{
+    char const* words[] = { "stream ", "lz4 ", "block ", "frame ", "nclib " };
+    u64 seed = 12345;
+
+    for (u64 i = 0; i < sizeof text;) {
+        seed = seed * 6364136223846793005u + 1442695040888963407u;
+        char const* word = words[(seed >> 33) % 5];
+        for (u64 j = 0; word[j] != '\0' and i < sizeof text; ++j) {
+            text[i++] = (u8)word[j];
+        }
+    }
+    for (u64 i = 0; i < sizeof noise; ++i) {
+        seed = seed * 6364136223846793005u + 1442695040888963407u;
+        noise[i] = (u8)(seed >> 56);
+    }
+}
+
+static void check_block_round_trip(u8 const* src, u64 size, u32 acceleration)
+{
+    MutStream compressed = mut_stream_new_growable_le(16);
+    u64 compressed_size = mut_stream_write_lz4_block(&compressed, src, size,
+                                                     acceleration);
+    cr_assert(eq(u64, compressed_size, mut_stream_tell(&compressed)));
+    cr_assert(compressed_size <= stream_lz4_compress_bound(size));
+
+    MutStream out = mut_stream_new_growable_le(16);
+    Stream stream = stream_new_le(mut_stream_raw(&compressed),
+                                  compressed_size);
+    cr_assert(eq(u64, stream_read_lz4_block(&stream, compressed_size, &out,
+                                            size),
+                 size));
+    cr_assert(eq(u64, stream_tell(&stream), compressed_size));
+    cr_assert_arr_eq(mut_stream_raw(&out), src, size);
+
+    mut_stream_free(&out);
+    mut_stream_free(&compressed);
+}
+
+Test(TestStreamLz4, test_lz4_block_round_trip)
+{
+    fill_data();
+
+    u64 sizes[] = { 0, 1, 12, 13, 100, 65536, sizeof text };
+
+    for (u64 k = 0; k < sizeof sizes / sizeof *sizes; ++k) {
+        check_block_round_trip(text, sizes[k],
+                               STREAM_LZ4_ACCELERATION_DEFAULT);
+        check_block_round_trip(text, sizes[k], STREAM_LZ4_ACCELERATION_FAST);
+    }
+    check_block_round_trip(noise, sizeof noise,
+                           STREAM_LZ4_ACCELERATION_DEFAULT);
+
+    // Runs make matches which overlap output.
+    u8 runs[1000];
+    for (u64 i = 0; i < sizeof runs; ++i) {
+        runs[i] = (u8)(i / 100 % 2 == 0 ? 'a' : "xyz"[i % 3]);
+    }
+    check_block_round_trip(runs, sizeof runs,
+                           STREAM_LZ4_ACCELERATION_DEFAULT);
+}
+
+Test(TestStreamLz4, test_lz4_block_compresses)
+{
+    fill_data();
+
+    MutStream compressed = mut_stream_new_growable_le(16);
+    u64 size = mut_stream_write_lz4_block(&compressed, text, sizeof text,
+                                          STREAM_LZ4_ACCELERATION_DEFAULT);
+    u64 fast_size = mut_stream_write_lz4_block(
+        &compressed, text, sizeof text, STREAM_LZ4_ACCELERATION_FAST);
+
+    cr_assert(size < sizeof text / 2);
+    cr_assert(fast_size >= size);
+
+    mut_stream_free(&compressed);
+}
+
+// Known block: "abc" literals, then match of 9 bytes at offset 3, then "de".
+Test(TestStreamLz4, test_lz4_block_fixed_dst)
+{
+    u8 block[] = { 0x35, 'a', 'b', 'c', 0x03, 0x00, 0x20, 'd', 'e' };
+    u8 buf[14];
+    MutStream out = mut_stream_new(buf, sizeof buf, STREAM_LITTLE_ENDIAN);
+    Stream stream = stream_new_le(block, sizeof block);
+
+    cr_assert(eq(u64, stream_read_lz4_block(&stream, sizeof block, &out,
+                                            sizeof buf),
+                 14));
+    cr_assert_arr_eq(buf, "abcabcabcabcde", 14);
+}
+
+Test(TestStreamLz4, test_lz4_block_malformed_fallible)
+{
+    // Offset points before start of output.
+    u8 block[] = { 0x10, 'a', 0x05, 0x00, 0x00 };
+    u8 buf[32];
+    MutStream out = mut_stream_new(buf, sizeof buf, STREAM_LITTLE_ENDIAN);
+    Stream stream = stream_new_fallible_le(block, sizeof block);
+
+    cr_assert(eq(u64, stream_read_lz4_block(&stream, sizeof block, &out,
+                                            sizeof buf),
+                 0));
+    cr_assert(stream_has_error(&stream));
+
+    // Output is smaller than decompressed data.
+    u8 literals[] = { 0x50, 'h', 'e', 'l', 'l', 'o' };
+    stream = stream_new_fallible_le(literals, sizeof literals);
+    out = mut_stream_new(buf, 4, STREAM_LITTLE_ENDIAN);
+    stream_read_lz4_block(&stream, sizeof literals, &out, 4);
+    cr_assert(stream_has_error(&stream));
+    cr_assert(eq(u64, mut_stream_tell(&out), 0));
+}
+
+Test(TestStreamLz4, test_lz4_frame_round_trip)
+{
+    fill_data();
+
+    MutStream frame = mut_stream_new_growable_le(16);
+    Lz4FrameWriter writer = mut_stream_lz4_frame_begin(
+        &frame, STREAM_LZ4_ACCELERATION_DEFAULT);
+    mut_stream_lz4_frame_write(&writer, &frame, text, sizeof text);
+    mut_stream_lz4_frame_write(&writer, &frame, noise, sizeof noise);
+    mut_stream_lz4_frame_end(&writer, &frame);
+
+    Stream stream = stream_new_le(mut_stream_raw(&frame),
+                                  mut_stream_tell(&frame));
+    MutStream out = mut_stream_new_growable_le(16);
+
+    // Decode block by block, every block fits in its own buffer.
+    Lz4FrameReader reader = stream_lz4_frame_begin(&stream);
+    u64 blocks = 0;
+    while (stream_lz4_frame_read_block(&reader, &stream, &out)) {
+        cr_assert(mut_stream_tell(&out) <= STREAM_LZ4_FRAME_BLOCK_SIZE);
+        mut_stream_seek(&out, 0, STREAM_START);
+        ++blocks;
+    }
+    cr_assert(eq(u64, blocks, 5));
+    cr_assert(eq(u64, stream_tell(&stream), mut_stream_tell(&frame)));
+
+    stream_seek(&stream, 0, STREAM_START);
+    cr_assert(eq(u64, stream_read_lz4_frame(&stream, &out),
+                 sizeof text + sizeof noise));
+    cr_assert_arr_eq(mut_stream_raw(&out), text, sizeof text);
+    cr_assert_arr_eq(mut_stream_raw(&out) + sizeof text, noise, sizeof noise);
+
+    mut_stream_free(&out);
+    mut_stream_free(&frame);
+}
+
+Test(TestStreamLz4, test_lz4_frame_corrupted_fallible)
+{
+    fill_data();
+
+    MutStream frame = mut_stream_new_growable_le(16);
+    Lz4FrameWriter writer = mut_stream_lz4_frame_begin(
+        &frame, STREAM_LZ4_ACCELERATION_DEFAULT);
+    mut_stream_lz4_frame_write(&writer, &frame, text, 1000);
+    mut_stream_lz4_frame_end(&writer, &frame);
+
+    u8* raw = (u8*)mut_stream_raw(&frame);
+    raw[mut_stream_tell(&frame) - 1] ^= 1;
+
+    Stream stream = stream_new_fallible_le(raw, mut_stream_tell(&frame));
+    MutStream out = mut_stream_new_growable_le(16);
+    stream_read_lz4_frame(&stream, &out);
+    cr_assert(stream_has_error(&stream));
+
+    // Truncated frame.
+    stream = stream_new_fallible_le(raw, 20);
+    stream_read_lz4_frame(&stream, &out);
+    cr_assert(stream_has_error(&stream));
+
+    mut_stream_free(&out);
+    mut_stream_free(&frame);
+}
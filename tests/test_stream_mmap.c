@@ -0,0 +1,91 @@
+// mkstemp is hidden by strict c2x mode.
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <criterion/criterion.h>
+#include <criterion/new/assert.h>
+
+#include "nclib/streams/stream_mmap.h"
+
+u8 be_payload[] = { 0x9c, 0xff, 0x9c, 0xff, 0xff, 0xff, 0x9c };
+
+const u8 u8_expected = 156; // 2^8  - 100
+const u16 u16_expected = 65436; // 2^16 - 100
+const u32 u32_expected = 4294967196; // 2^32 - 100
+
+static void create_file(char* path, u8 const* data, u64 size)
+{
+    int fd = mkstemp(path);
+    cr_assert(ge(i32, fd, 0));
+    cr_assert(eq(i64, write(fd, data, size), (i64)size));
+    close(fd);
+}
+
+Test(TestStreamMmap, test_stream_open_mmap)
+{
+    char path[] = "/tmp/nclib_mmap_XXXXXX";
+    create_file(path, be_payload, sizeof be_payload);
+
+    Stream s;
+    cr_assert(stream_open_mmap(&s, path, STREAM_BIG_ENDIAN,
+                               STREAM_MMAP_SEQUENTIAL | STREAM_MMAP_POPULATE));
+    cr_assert(eq(u64, stream_size(&s), sizeof be_payload));
+    cr_assert(eq(u8, stream_read_u8(&s), u8_expected));
+    cr_assert(eq(u16, stream_read_u16(&s), u16_expected));
+    cr_assert(eq(u32, stream_read_u32(&s), u32_expected));
+
+    stream_close_mmap(&s);
+    cr_assert(eq(u64, stream_size(&s), 0));
+    unlink(path);
+}
+
+Test(TestStreamMmap, test_stream_open_mmap_empty_file)
+{
+    char path[] = "/tmp/nclib_mmap_XXXXXX";
+    create_file(path, be_payload, 0);
+
+    Stream s;
+    cr_assert(stream_open_mmap(&s, path, STREAM_BIG_ENDIAN,
+                               STREAM_MMAP_DEFAULT));
+    cr_assert(eq(u64, stream_size(&s), 0));
+
+    stream_close_mmap(&s);
+    unlink(path);
+}
+
+Test(TestStreamMmap, test_stream_open_mmap_missing_file)
+{
+    Stream s;
+    cr_assert(not stream_open_mmap(&s, "/tmp/nclib_mmap_missing/file",
+                                   STREAM_BIG_ENDIAN, STREAM_MMAP_DEFAULT));
+}
+
+Test(TestStreamMmap, test_mut_stream_open_mmap)
+{
+    char path[] = "/tmp/nclib_mmap_XXXXXX";
+    create_file(path, be_payload, 0);
+
+    MutStream s;
+    cr_assert(mut_stream_open_mmap(&s, path, sizeof be_payload,
+                                   STREAM_BIG_ENDIAN, STREAM_MMAP_RANDOM));
+    cr_assert(eq(u64, mut_stream_size(&s), sizeof be_payload));
+    mut_stream_write_u8(&s, u8_expected);
+    mut_stream_write_u16(&s, u16_expected);
+    mut_stream_write_u32(&s, u32_expected);
+    mut_stream_close_mmap(&s);
+
+    Stream res;
+    cr_assert(stream_open_mmap(&res, path, STREAM_BIG_ENDIAN,
+                               STREAM_MMAP_DEFAULT));
+    cr_assert_arr_eq(stream_raw(&res), be_payload, sizeof be_payload);
+    stream_close_mmap(&res);
+
+    cr_assert(mut_stream_open_mmap(&s, path, 0, STREAM_BIG_ENDIAN,
+                                   STREAM_MMAP_DEFAULT));
+    cr_assert(eq(u64, mut_stream_size(&s), sizeof be_payload));
+    mut_stream_close_mmap(&s);
+    unlink(path);
+}
@@ -0,0 +1,145 @@
+#include <criterion/criterion.h>
+#include <criterion/new/assert.h>
+
+#include "nclib/streams/stream_record.h"
+
+// Struct has padding, so fields are loaded one by one.
+#define ADDR_FIELDS(X)                                                        \
+    X(i32, page_id)                                                           \
+    X(i16, offset)
+
+STREAM_RECORD_DEFINE(Addr, addr, ADDR_FIELDS)
+
+// Struct without padding, copied by memcpy when endian matches.
+#define HEADER_FIELDS(X)                                                      \
+    X(u32, magic)                                                             \
+    X(u16, version)                                                           \
+    X(u16, flags)                                                             \
+    X(u64, id)
+
+STREAM_RECORD_DEFINE(Header, header, HEADER_FIELDS)
+
+#define POINT_FIELDS(X)                                                       \
+    X(f32, x)                                                                 \
+    X(f64, y)                                                                 \
+    X(i8, layer)                                                              \
+    X(bool, visible)
+
+STREAM_RECORD_DEFINE(Point, point, POINT_FIELDS)
+
+// Addr {.page_id = 100, .offset=234}
+u8 le_addr[] = { 0x64, 0x0, 0x0, 0x0, 0xea, 0x0 };
+u8 be_addr[] = { 0x0, 0x0, 0x0, 0x64, 0x0, 0xea };
+
+u8 le_header[] = { 0x78, 0x56, 0x34, 0x12, 0x02, 0x00, 0x01, 0x80,
+                   0x08, 0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01 };
+u8 be_header[] = { 0x12, 0x34, 0x56, 0x78, 0x00, 0x02, 0x80, 0x01,
+                   0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08 };
+
+Test(TestStreamRecord, test_wire_size)
+{
+    cr_assert(eq(u64, addr_wire_size(), 6));
+    cr_assert(eq(u64, header_wire_size(), 16));
+    cr_assert(eq(u64, point_wire_size(), 14));
+}
+
+Test(TestStreamRecord, test_stream_read_addr)
+{
+    Stream be_stream = stream_new_be(be_addr, sizeof be_addr);
+    Addr addr = stream_read_addr(&be_stream);
+
+    cr_assert(eq(i32, addr.page_id, 100));
+    cr_assert(eq(i16, addr.offset, 234));
+    cr_assert(eq(u64, stream_tell(&be_stream), sizeof be_addr));
+
+    Stream le_stream = stream_new_le(le_addr, sizeof le_addr);
+    addr = stream_read_addr(&le_stream);
+
+    cr_assert(eq(i32, addr.page_id, 100));
+    cr_assert(eq(i16, addr.offset, 234));
+}
+
+Test(TestStreamRecord, test_mut_stream_write_addr)
+{
+    Addr addr = { .page_id = 100, .offset = 234 };
+    u8 buf[sizeof be_addr];
+
+    MutStream be_stream = mut_stream_new_be(buf, sizeof buf);
+    mut_stream_write_addr(&be_stream, addr);
+    cr_assert_arr_eq(buf, be_addr, sizeof be_addr);
+    cr_assert(eq(u64, mut_stream_tell(&be_stream), sizeof be_addr));
+
+    MutStream le_stream = mut_stream_new_le(buf, sizeof buf);
+    mut_stream_write_addr(&le_stream, addr);
+    cr_assert_arr_eq(buf, le_addr, sizeof le_addr);
+}
+
+Test(TestStreamRecord, test_header_both_endians)
+{
+    Stream be_stream = stream_new_be(be_header, sizeof be_header);
+    Stream le_stream = stream_new_le(le_header, sizeof le_header);
+    Header be = stream_read_header(&be_stream);
+    Header le = stream_read_header(&le_stream);
+
+    cr_assert(eq(u32, be.magic, 0x12345678));
+    cr_assert(eq(u16, be.version, 2));
+    cr_assert(eq(u16, be.flags, 0x8001));
+    cr_assert(eq(u64, be.id, 0x0102030405060708));
+    cr_assert(eq(u32, le.magic, be.magic));
+    cr_assert(eq(u16, le.version, be.version));
+    cr_assert(eq(u16, le.flags, be.flags));
+    cr_assert(eq(u64, le.id, be.id));
+
+    u8 buf[sizeof be_header];
+    MutStream stream = mut_stream_new_be(buf, sizeof buf);
+    mut_stream_write_header(&stream, be);
+    cr_assert_arr_eq(buf, be_header, sizeof be_header);
+
+    stream = mut_stream_new_le(buf, sizeof buf);
+    mut_stream_write_header(&stream, le);
+    cr_assert_arr_eq(buf, le_header, sizeof le_header);
+}
+
+Test(TestStreamRecord, test_array_round_trip)
+{
+    Point points[3] = {
+        { .x = 1.5f, .y = -2.25, .layer = -1, .visible = true },
+        { .x = 0.0f, .y = 1e10, .layer = 7, .visible = false },
+        { .x = -3.0f, .y = 0.5, .layer = 0, .visible = true },
+    };
+
+    StreamEndian endians[] = { STREAM_LITTLE_ENDIAN, STREAM_BIG_ENDIAN };
+
+    for (u64 e = 0; e < 2; ++e) {
+        StreamEndian endian = endians[e];
+        MutStream out = mut_stream_new_growable(16, endian);
+        mut_stream_write_point_array(&out, points, 3);
+        cr_assert(eq(u64, mut_stream_tell(&out), 3 * point_wire_size()));
+
+        Stream in = stream_new(mut_stream_raw(&out), mut_stream_tell(&out),
+                               endian);
+        Point read[3];
+        stream_read_point_array(&in, read, 3);
+
+        for (u64 i = 0; i < 3; ++i) {
+            cr_assert(eq(flt, read[i].x, points[i].x));
+            cr_assert(eq(dbl, read[i].y, points[i].y));
+            cr_assert(eq(i8, read[i].layer, points[i].layer));
+            cr_assert(eq(u8, read[i].visible, points[i].visible));
+        }
+        cr_assert(eq(u64, stream_tell(&in), stream_size(&in)));
+
+        mut_stream_free(&out);
+    }
+}
+
+Test(TestStreamRecord, test_fallible_read_out_of_bound)
+{
+    Stream stream = stream_new_fallible_be(be_header, sizeof be_header - 1);
+    Header header = stream_read_header(&stream);
+
+    cr_assert(stream_has_error(&stream));
+    cr_assert(eq(u32, header.magic, 0));
+    cr_assert(eq(u64, header.id, 0));
+    cr_assert(eq(u64, stream_tell(&stream), sizeof be_header - 1));
+}
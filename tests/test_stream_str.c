@@ -0,0 +1,64 @@
+#include <string.h>
+
+#include <criterion/criterion.h>
+#include <criterion/new/assert.h>
+
+#include "nclib/alloc/arena.h"
+#include "nclib/streams/stream_arena.h"
+#include "nclib/streams/stream_str.h"
+
+u8 payload[] = { 0x05, 'h', 'e', 'l', 'l', 'o', 0x2a };
+
+Test(TestStreamStr, test_stream_read_str_view)
+{
+    Stream stream = stream_new_be(payload, sizeof payload);
+
+    StrView view = stream_read_str_view(&stream);
+
+    cr_assert(str_view_eq(view, str_view_from_cstr("hello")));
+    cr_assert(eq(ptr, (void*)view.ptr, (void*)(payload + 1)));
+    cr_assert(eq(u8, stream_read_u8(&stream), 0x2a));
+}
+
+Test(TestStreamStr, test_stream_read_str)
+{
+    Stream stream = stream_new_le(payload, sizeof payload);
+
+    Str str = stream_read_str(&stream);
+
+    cr_assert(eq(i32, strcmp(str_cstr(&str), "hello"), 0));
+    cr_assert(eq(u64, stream_tell(&stream), 6));
+    str_free(&str);
+}
+
+Test(TestStreamStr, test_mut_stream_write_str_view)
+{
+    u8 buf[6];
+    MutStream stream = mut_stream_new_be(buf, sizeof buf);
+
+    mut_stream_write_str_view(&stream, str_view_from_cstr("hello"));
+
+    cr_assert_arr_eq(buf, payload, sizeof buf);
+}
+
+Test(TestStreamStr, test_str_read_by_arena)
+{
+    char chars[200];
+    memset(chars, 'a', sizeof chars);
+    u8 buf[256];
+    MutStream out = mut_stream_new_le(buf, sizeof buf);
+
+    // Length above 127 takes two varint bytes.
+    mut_stream_write_str_view(&out, str_view_new(chars, sizeof chars));
+    cr_assert(eq(u64, mut_stream_tell(&out), 2 + sizeof chars));
+
+    Arena arena = arena_new(0);
+    Stream in = stream_new_le(buf, mut_stream_tell(&out));
+    u64 len;
+    char* str = stream_read_varstr_arena(&in, &arena, &len);
+
+    cr_assert(eq(u64, len, sizeof chars));
+    cr_assert(eq(i32, strncmp(str, chars, len), 0));
+    cr_assert(eq(u8, (u8)str[len], 0));
+    arena_free(&arena);
+}
@@ -0,0 +1,115 @@
+#include <criterion/criterion.h>
+#include <criterion/new/assert.h>
+
+#include "nclib/streams/stream_vbyte.h"
+
+// Lengths 1, 2, 3, 4 give control byte 0b11100100.
+u32 nums[] = { 0x12, 0x3456, 0x789abc, 0xdef01234, 0x56 };
+u8 encoded[] = { 0xe4, 0x00, 0x12, 0x56, 0x34, 0xbc, 0x9a, 0x78,
+                 0x34, 0x12, 0xf0, 0xde, 0x56 };
+
+Test(TestStreamVbyte, test_stream_vbyte_size_bound)
+{
+    cr_assert(eq(u64, stream_vbyte_size_bound(0), 0));
+    cr_assert(eq(u64, stream_vbyte_size_bound(1), 5));
+    cr_assert(eq(u64, stream_vbyte_size_bound(5), 22));
+}
+
+Test(TestStreamVbyte, test_mut_stream_write_vbyte_u32_array)
+{
+    u8 buf[sizeof encoded];
+    MutStream stream = mut_stream_new_be(buf, sizeof buf);
+
+    mut_stream_write_vbyte_u32_array(&stream, nums, 5);
+
+    cr_assert(eq(u64, mut_stream_tell(&stream), sizeof encoded));
+    cr_assert_arr_eq(buf, encoded, sizeof encoded);
+}
+
+Test(TestStreamVbyte, test_stream_read_vbyte_u32_array)
+{
+    Stream stream = stream_new_be(encoded, sizeof encoded);
+    u32 dst[5];
+
+    stream_read_vbyte_u32_array(&stream, dst, 5);
+
+    cr_assert(eq(u64, stream_tell(&stream), sizeof encoded));
+    cr_assert_arr_eq(dst, nums, sizeof nums);
+}
+
+Test(TestStreamVbyte, test_stream_read_vbyte_fallible_truncated)
+{
+    // Last data byte is cut off.
+    Stream stream = stream_new_fallible_be(encoded, sizeof encoded - 1);
+    u32 dst[5] = { 1, 1, 1, 1, 1 };
+    u32 zeros[5] = { 0 };
+
+    stream_read_vbyte_u32_array(&stream, dst, 5);
+
+    cr_assert(stream_has_error(&stream));
+    cr_assert(eq(u64, stream_tell(&stream), sizeof encoded - 1));
+    cr_assert_arr_eq(dst, zeros, sizeof zeros);
+}
+
+Test(TestStreamVbyte, test_stream_vbyte_round_trip)
+{
+    u32 src[1000];
+    u32 dst[1000];
+    u32 seed = 7;
+    for (u64 i = 0; i < 1000; ++i) {
+        seed = seed * 1103515245 + 12345;
+        src[i] = seed >> (seed % 32);
+    }
+
+    // Sizes which aren't divisible by 4 check scalar tail.
+    for (u64 count = 0; count < 1000; count += 97) {
+        MutStream out = mut_stream_new_growable_le(0);
+        mut_stream_write_vbyte_u32_array(&out, src, count);
+        mut_stream_write_u8(&out, 0xaa);
+
+        Stream in = stream_new_le(mut_stream_raw(&out), mut_stream_tell(&out));
+        stream_read_vbyte_u32_array(&in, dst, count);
+
+        cr_assert_arr_eq(dst, src, count * sizeof(u32));
+        cr_assert(eq(u8, stream_read_u8(&in), 0xaa));
+        mut_stream_free(&out);
+    }
+}
+
+Test(TestStreamVbyte, test_stream_vbyte_delta_round_trip)
+{
+    u32 src[1000];
+    u32 dst[1000];
+    u32 num = 100;
+    for (u64 i = 0; i < 1000; ++i) {
+        num += (u32)(i * i % 70001);
+        src[i] = num;
+    }
+
+    MutStream out = mut_stream_new_growable_le(0);
+    mut_stream_write_vbyte_u32_array_delta(&out, src, 1000, 100);
+    u64 delta_size = mut_stream_tell(&out);
+
+    Stream in = stream_new_le(mut_stream_raw(&out), delta_size);
+    stream_read_vbyte_u32_array_delta(&in, dst, 1000, 100);
+
+    cr_assert_arr_eq(dst, src, sizeof src);
+    cr_assert(eq(u64, stream_tell(&in), delta_size));
+    cr_assert(lt(u64, delta_size, stream_vbyte_size_bound(1000)));
+    mut_stream_free(&out);
+}
+
+Test(TestStreamVbyte, test_stream_vbyte_delta_wraps)
+{
+    u32 src[] = { 5, 3, 0xffffffff, 0 };
+    u32 dst[4];
+    u8 buf[32];
+
+    MutStream out = mut_stream_new_le(buf, sizeof buf);
+    mut_stream_write_vbyte_u32_array_delta(&out, src, 4, 10);
+
+    Stream in = stream_new_le(buf, mut_stream_tell(&out));
+    stream_read_vbyte_u32_array_delta(&in, dst, 4, 10);
+
+    cr_assert_arr_eq(dst, src, sizeof src);
+}
@@ -0,0 +1,34 @@
+#include <criterion/criterion.h>
+#include <criterion/new/assert.h>
+
+#include "nclib/checksum/xxh32.h"
+
+Test(TestXxh32, test_xxh32_known_values)
+{
+    char const* text = "Nobody inspects the spammish repetition";
+
+    cr_assert(eq(u32, xxh32(0, "", 0), 0x02cc5d05));
+    cr_assert(eq(u32, xxh32(0, "a", 1), 0x550d7456));
+    cr_assert(eq(u32, xxh32(0, "abc", 3), 0x32d153ff));
+    cr_assert(eq(u32, xxh32(0, text, strlen(text)), 0xe2293b2f));
+}
+
+Test(TestXxh32, test_xxh32_incremental)
+{
+    u8 buf[1000];
+    for (u64 i = 0; i < sizeof buf; ++i) {
+        buf[i] = (u8)(i * 31 + 7);
+    }
+
+    u64 sizes[] = { 1, 3, 15, 16, 17, 100, 333 };
+    for (u64 k = 0; k < sizeof sizes / sizeof *sizes; ++k) {
+        Xxh32 state = xxh32_begin(42);
+
+        for (u64 i = 0; i < sizeof buf; i += sizes[k]) {
+            u64 size = sizeof buf - i < sizes[k] ? sizeof buf - i : sizes[k];
+            xxh32_update(&state, buf + i, size);
+        }
+
+        cr_assert(eq(u32, xxh32_end(&state), xxh32(42, buf, sizeof buf)));
+    }
+}